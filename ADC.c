@@ -17,6 +17,8 @@
 #include "serialMonitor.h"
 #endif
 
+const unsigned char analogChannelCode[4] = {CT, WindSpeed, Temperature, RTCBattery}; // ADPCH value of each analog channel
+
 void selectChannel(unsigned char channel) {
 	switch(channel) {
     case 0 :
@@ -79,3 +81,269 @@ unsigned int getADCResult(void) {
 #endif
 	return adcResult;
 } 
+
+/*************Motor current sampling#Start**********/
+
+/*************************************************************************************************************************
+
+This function is called to start sampling window of motor CT output.
+The purpose of this function is to trigger ADC conversion of CT channel on every Timer2 period of 1 msec.
+Each conversion is accumulated in ADC interrupt and RMS value is calculated over whole mains cycles.
+Sampling stops by itself after one window so that ADC interrupt does not wake up system from sleep.
+
+ **************************************************************************************************************************/
+void startMotorCurrentSampling(void) {
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("startMotorCurrentSampling_IN\r\n");
+    //********Debug log#end**************//
+#endif
+    T2CONbits.TMR2ON = OFF; // Stop conversion trigger
+    PIE1bits.ADIE = DISABLED; // Disables the ADC Interrupt
+    selectChannel(CTchannel);
+    ctSquareSum = CLEAR;
+    ctSampleSum = CLEAR;
+    ctSampleCount = CLEAR;
+    ctSamplingActive = true;
+    ADACT = ctAutoConversionTrigger; // Start ADC conversion on each Timer2 period
+    PIR1bits.ADIF = CLEAR; // Clear ADC Interrupt at start
+    PIE1bits.ADIE = ENABLED; // Enables the ADC Interrupt
+    T2TMR = CLEAR;
+    T2CONbits.TMR2ON = ON; // Start conversion trigger
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("startMotorCurrentSampling_OUT\r\n");
+    //********Debug log#end**************//
+#endif
+}
+
+/*************************************************************************************************************************
+
+This function is called to stop sampling of motor CT output after motor is switched off.
+The purpose of this function is to abort Timer2 triggered ADC conversion and to restart filter for next motor on period.
+
+ **************************************************************************************************************************/
+void stopMotorCurrentSampling(void) {
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("stopMotorCurrentSampling_IN\r\n");
+    //********Debug log#end**************//
+#endif
+    T2CONbits.TMR2ON = OFF; // Stop conversion trigger
+    ADACT = 0x00; // Auto conversion trigger disabled
+    PIE1bits.ADIE = DISABLED; // Disables the ADC Interrupt
+    PIR1bits.ADIF = CLEAR;
+    ctSamplingActive = false;
+    motorCurrentReady = false; // Filter restarts with next sampling window
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("stopMotorCurrentSampling_OUT\r\n");
+    //********Debug log#end**************//
+#endif
+}
+
+/*************************************************************************************************************************
+
+This function is called from ADC interrupt after each CT channel conversion.
+The purpose of this function is to accumulate CT sample and its square and to calculate RMS value after each sampling window.
+Mean of window is DC offset of CT output, it is removed so that RMS value is of AC motor current only.
+RMS value is filtered with low pass filter of 1/4 gain to publish stable motor current.
+
+ **************************************************************************************************************************/
+void accumulateMotorCurrentSample(void) {
+    unsigned int ctSample = CLEAR;
+    unsigned long ctMean = CLEAR;
+    unsigned long ctMeanSquare = CLEAR;
+    ctSample = ADRESL;
+    ctSample |= ((unsigned int)ADRESH) << 8;
+    ctSampleSum += ctSample;
+    ctSquareSum += (unsigned long)ctSample * ctSample;
+    ctSampleCount++;
+    if (ctSampleCount == ctSamplesPerWindow) {
+        ctMean = ctSampleSum / ctSamplesPerWindow;
+        ctMeanSquare = ctSquareSum / ctSamplesPerWindow;
+        // Variance of window is mean of squares less square of mean
+        motorCurrentRMS = integerSquareRoot((ctMeanSquare > ctMean * ctMean) ? (ctMeanSquare - ctMean * ctMean) : 0);
+        if (motorCurrentReady) {
+            motorCurrentAccumulator = motorCurrentAccumulator - (motorCurrentAccumulator >> 2) + motorCurrentRMS;
+        }
+        else {
+            motorCurrentAccumulator = motorCurrentRMS << 2; // Load filter with first window value
+            motorCurrentReady = true;
+        }
+        analogValue[CTchannel] = motorCurrentAccumulator >> 2;
+        // Stop sampling after window is completed
+        T2CONbits.TMR2ON = OFF;
+        ADACT = 0x00;
+        PIE1bits.ADIE = DISABLED;
+        ctSamplingActive = false;
+    }
+}
+
+/*************************************************************************************************************************
+
+This function is called to sample one window of motor CT output.
+The purpose of this function is to update filtered motor current before system goes into sleep.
+It waits until window of 200 msec is sampled by ADC interrupt, sampling is aborted after ctSamplingTimeout
+and last filtered motor current is kept if window is not completed.
+
+ **************************************************************************************************************************/
+void sampleMotorCurrent(void) {
+    unsigned int waitTime = CLEAR;
+    startMotorCurrentSampling();
+    // Wait until sampling window is completed
+    while (ctSamplingActive && waitTime < ctSamplingTimeout) {
+        myMsDelay(1);
+        waitTime++;
+    }
+    if (ctSamplingActive) {
+        T2CONbits.TMR2ON = OFF; // Stop conversion trigger
+        ADACT = 0x00; // Auto conversion trigger disabled
+        PIE1bits.ADIE = DISABLED; // Disables the ADC Interrupt
+        ctSamplingActive = false;
+    #ifdef DEBUG_MODE_ON_H
+        //********Debug log#start************//
+        transmitStringToDebug("sampleMotorCurrent_Timeout\r\n");
+        //********Debug log#end**************//
+    #endif
+    }
+}
+
+/*************************************************************************************************************************
+
+This function is called to calculate integer square root.
+The purpose of this function is to calculate square root by bitwise method without division.
+
+ **************************************************************************************************************************/
+unsigned int integerSquareRoot(unsigned long value) {
+    unsigned long root = CLEAR;
+    unsigned long bit = 0x40000000; // Highest power of 4 in 32 bit
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (unsigned int)root;
+}
+
+/*************Motor current sampling#End**********/
+
+/*************Analog channel scan#Start**********/
+
+/*************************************************************************************************************************
+
+This function is called to scan wind speed, temperature and RTC battery channels in background.
+The purpose of this function is to update analog value table with average of 16 conversions of each channel.
+Conversions are accumulated and averaged by ADC computation unit in burst average mode and each channel is
+sequenced from ADC threshold interrupt at end of burst, so no conversion is waited for in software.
+RTC battery is measured only in every 16th scan as measurement line draws current from RTC battery.
+Scan is aborted after analogScanTimeout and last values of channels not converted are kept.
+
+ **************************************************************************************************************************/
+void scanAnalogChannels(void) {
+    unsigned int waitTime = CLEAR;
+    _Bool rtcScan = false;
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("scanAnalogChannels_IN\r\n");
+    //********Debug log#end**************//
+#endif
+    if (analogScanCount == 0 || !analogValueReady) {
+        rtcScan = true;
+        RTC_Trigger = ENABLED;
+        myMsDelay(50); // Settle RTC battery measurement line
+        analogLastChannel = RTCchannel;
+    }
+    else {
+        analogLastChannel = TPchannel;
+    }
+    analogScanCount++;
+    if (analogScanCount == rtcScanInterval) {
+        analogScanCount = CLEAR;
+    }
+    ADCON2 = analogBurstAverageMode;
+    ADCON3 = analogThresholdAlways;
+    ADRPT = analogSamplesPerChannel;
+    analogScanChannel = WSchannel;
+    ADPCH = analogChannelCode[analogScanChannel];
+    analogScanActive = true;
+    PIR1bits.ADTIF = CLEAR; // Clear ADC Threshold Interrupt at start
+    PIE1bits.ADTIE = ENABLED; // Enables the ADC Threshold Interrupt
+    ADCON2bits.ADACLR = SET; // Clear accumulator before first burst
+    ADCON0bits.GO = SET; // Start burst of first channel
+    // Wait until last channel is converted
+    while (analogScanActive && waitTime < analogScanTimeout) {
+        myMsDelay(1);
+        waitTime++;
+    }
+    PIE1bits.ADTIE = DISABLED; // Disables the ADC Threshold Interrupt
+    if (analogScanActive) {
+        ADCON0bits.GO = CLEAR; // Abort burst in progress
+        analogScanActive = false;
+        rtcScan = false; // RTC battery value is not updated
+    #ifdef DEBUG_MODE_ON_H
+        //********Debug log#start************//
+        transmitStringToDebug("scanAnalogChannels_Timeout\r\n");
+        //********Debug log#end**************//
+    #endif
+    }
+    RTC_Trigger = DISABLED;
+    // Restore basic mode for CT sampling and single conversions
+    ADCON2 = 0x00;
+    ADCON3 = 0x00;
+    ADRPT = 0x00;
+    if (rtcScan) {
+        analogValueReady = true;
+    }
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("scanAnalogChannels_OUT\r\n");
+    //********Debug log#end**************//
+#endif
+}
+
+/*************************************************************************************************************************
+
+This function is called from ADC threshold interrupt at end of each burst of background scan.
+The purpose of this function is to store averaged result of current channel and to start burst of next channel.
+
+ **************************************************************************************************************************/
+void storeAnalogScanResult(void) {
+    unsigned int average = CLEAR;
+    average = ADFLTRL;
+    average |= ((unsigned int)ADFLTRH) << 8;
+    analogValue[analogScanChannel] = average;
+    if (analogScanChannel < analogLastChannel) {
+        analogScanChannel++;
+        ADPCH = analogChannelCode[analogScanChannel];
+        ADCON2bits.ADACLR = SET;
+        ADCON0bits.GO = SET; // Start burst of next channel
+    }
+    else {
+        PIE1bits.ADTIE = DISABLED;
+        analogScanActive = false;
+    }
+}
+
+/*************************************************************************************************************************
+
+This function is called to read latest value of analog channel from analog value table.
+The purpose of this function is to read value updated in ADC interrupt without interruption.
+
+ **************************************************************************************************************************/
+unsigned int getAnalogValue(unsigned char channel) {
+    unsigned int value = CLEAR;
+    INTCONbits.GIEL = DISABLED; // Hold low priority interrupt while reading 16 bit value
+    value = analogValue[channel];
+    INTCONbits.GIEL = ENABLED;
+    return value;
+}
+/*************Analog channel scan#End**********/
@@ -13,6 +13,14 @@
 
 void selectChannel(unsigned char);
 unsigned int getADCResult(void);
+void startMotorCurrentSampling(void);       // Start Timer2 triggered CT sampling
+void stopMotorCurrentSampling(void);        // Stop Timer2 triggered CT sampling
+void sampleMotorCurrent(void);              // Sample one window of CT output
+void accumulateMotorCurrentSample(void);    // Accumulate CT sample in ADC interrupt
+unsigned int integerSquareRoot(unsigned long); // Square root without division
+void scanAnalogChannels(void);              // Scan WS, TP and RTC channels with hardware averaging
+void storeAnalogScanResult(void);           // Store channel average in ADC threshold interrupt
+unsigned int getAnalogValue(unsigned char); // Read latest value of analog channel
 
 #endif
  /* ADC_H */
\ No newline at end of file
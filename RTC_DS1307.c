@@ -21,35 +21,34 @@
 /*Feed Current timestamp from gsm in to RTC*/
 void feedTimeInRTC(void) {
     unsigned char day = 0x01; // Storing dummy day 'Monday'
-    /* Convert time stamp to BCD format*/
     setBCDdigit(0x0E,1); // (t) BCD indication for RTC Clock feed Action
-    myMsDelay(500);
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
     transmitStringToDebug("feedTimeInRTC_IN\r\n");
     //********Debug log#end**************//
 #endif
-    currentSeconds = decimal2BCD(currentSeconds); 
-    currentMinutes = decimal2BCD(currentMinutes);
-    currentHour = decimal2BCD(currentHour);
-    currentDD = decimal2BCD(currentDD);
-    currentMM = decimal2BCD(currentMM);
-    currentYY = decimal2BCD(currentYY);
-    i2cStart();          /*start condition */
-    
-    i2cSend(0xD0);     /* slave address with write mode */
-    i2cSend(0x00);     /* address of seconds register written to the pointer */ 
-    
-    i2cSend(currentSeconds);  /*time register values */
-    i2cSend(currentMinutes);
-    i2cSend(currentHour);
-    
-    i2cSend(day);      /*date registers */
-    i2cSend(currentDD);
-    i2cSend(currentMM);
-    i2cSend(currentYY);
-    
-    i2cStop();          /*i2c stop condition */
+    /* Convert time stamp to BCD format*/
+    rtcRegister[0] = decimal2BCD(currentSeconds);
+    rtcRegister[1] = decimal2BCD(currentMinutes);
+    rtcRegister[2] = decimal2BCD(currentHour);
+    rtcRegister[3] = day;
+    rtcRegister[4] = decimal2BCD(currentDD);
+    rtcRegister[5] = decimal2BCD(currentMM);
+    rtcRegister[6] = decimal2BCD(currentYY);
+    rtcTransferDone = false;
+    rtcTransferFailed = true;
+    // Burst write of time and date registers starting from seconds register
+    if (queueI2CTransaction(rtcSlaveAddress, rtcSecondsRegister, rtcRegister, rtcRegisterCount, false, rtcTimeWritten)) {
+        waitForRtcTransfer(); // Wait until transaction is completed in I2C interrupt
+    }
+    setSystemClock(); // Resync system clock with fed time, system clock keeps time even if RTC is not written
+#ifdef DEBUG_MODE_ON_H
+    if (rtcTransferFailed) {
+        //********Debug log#start************//
+        transmitStringToDebug("feedTimeInRTC_Failed\r\n");
+        //********Debug log#end**************//
+    }
+#endif
     setBCDdigit(0x0F,0); // Blank BCD Indication for Normal Condition
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
@@ -75,42 +74,189 @@ unsigned char bcd2Decimal (unsigned char bcd)
     return temp;
 }
 
-/* Fetch Current timestamp from RTC */
-void fetchTimefromRTC(void) {
-    unsigned char day = 0x01; // Storing dummy day 'Monday'
+/* Fetch Current timestamp from RTC, false is returned and current time stamp is left unchanged if RTC fails */
+_Bool fetchTimefromRTC(void) {
     setBCDdigit(0x0E,0);  // (t.) BCD indication for RTC Clock fetch action
-    myMsDelay(500);
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
     transmitStringToDebug("fetchTimefromRTC_IN\r\n");
     //********Debug log#end**************//
 #endif
-    i2cStart();
-	i2cSend(0xD0);
-	i2cSend(0x00);
-	i2cRestart();
-	i2cSend(0xD1);
-	currentSeconds = i2cRead(1); /* Read the slave with ACK */
-	currentMinutes = i2cRead(1);
-	currentHour = i2cRead(1);
-    day = i2cRead(1);
-	currentDD = i2cRead(1);
-	currentMM = i2cRead(1);
-	currentYY = i2cRead(0);
-    i2cStop();
-    
-    /* Convert Timestamp to decimal*/
-    currentSeconds = bcd2Decimal(currentSeconds); 
-    currentMinutes = bcd2Decimal(currentMinutes);
-    currentHour = bcd2Decimal(currentHour);
-    currentDD = bcd2Decimal(currentDD);
-    currentMM = bcd2Decimal(currentMM);
-    currentYY = bcd2Decimal(currentYY);
+    rtcTransferDone = false;
+    rtcTransferFailed = true;
+    // Burst read of time and date registers starting from seconds register
+    if (queueI2CTransaction(rtcSlaveAddress, rtcSecondsRegister, rtcRegister, rtcRegisterCount, true, rtcTimeReceived)) {
+        waitForRtcTransfer(); // Wait until transaction is completed in I2C interrupt
+    }
     setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
     transmitStringToDebug("fetchTimefromRTC_OUT\r\n");
     //********Debug log#end**************//
+#endif
+    return !rtcTransferFailed;
+}
+
+/*************************************************************************************************************************
+
+This function is called to wait until queued RTC transfer is completed in I2C interrupt.
+The purpose of this function is to bound wait for RTC which does not respond or holds bus.
+Transaction is aborted and MSSP is reset after rtcTransferTimeout, true is returned if transfer is succeeded.
+
+ **************************************************************************************************************************/
+_Bool waitForRtcTransfer(void) {
+    unsigned char waitTime = CLEAR;
+    while (!rtcTransferDone && waitTime < rtcTransferTimeout) {
+        myMsDelay(1);
+        waitTime++;
+    }
+    if (!rtcTransferDone) {
+        INTCONbits.GIEL = DISABLED; // Hold low priority interrupt while queue is modified
+        SSP2CON1bits.SSPEN = 0; // Reset MSSP to release bus
+        abortI2CTransaction(); // Failure is reported to callback
+        SSP2CON1bits.SSPEN = 1;
+        INTCONbits.GIEL = ENABLED;
+    }
+    return (rtcTransferDone && !rtcTransferFailed);
+}
+
+/* Called from I2C interrupt after burst read of RTC registers */
+void rtcTimeReceived(_Bool success) {
+    // Time stamp out of range is not taken i.e. RTC registers are read wrong or RTC lost time
+    success = success && (rtcRegister[0] & 0x7F) <= 0x59 && rtcRegister[1] <= 0x59 && rtcRegister[2] <= 0x23
+              && rtcRegister[4] >= 0x01 && rtcRegister[4] <= 0x31 && rtcRegister[5] >= 0x01 && rtcRegister[5] <= 0x12;
+    /* Convert Timestamp to decimal*/
+    if (success) {
+        currentSeconds = bcd2Decimal(rtcRegister[0] & 0x7F); // Clock halt bit is masked
+        currentMinutes = bcd2Decimal(rtcRegister[1]);
+        currentHour = bcd2Decimal(rtcRegister[2]);
+        currentDD = bcd2Decimal(rtcRegister[4]);
+        currentMM = bcd2Decimal(rtcRegister[5]);
+        currentYY = bcd2Decimal(rtcRegister[6]);
+    }
+    rtcTransferFailed = !success;
+    rtcTransferDone = true;
+}
+
+/* Called from I2C interrupt after burst write of RTC registers */
+void rtcTimeWritten(_Bool success) {
+    rtcTransferFailed = !success;
+    rtcTransferDone = true;
+}
+
+/****************System clock*****************/
+
+/*************************************************************************************************************************
+
+This function is called to advance system clock maintained in RAM by given seconds.
+The purpose of this function is to keep wall clock without I2C transaction to RTC.
+It is called from Timer0 interrupt each minute while motor is ON and after each sleep count while motor is OFF.
+
+ **************************************************************************************************************************/
+void advanceSystemClock(unsigned char seconds) {
+    unsigned char monthDays = CLEAR;
+    clockSeconds += seconds;
+    while (clockSeconds >= 60) {
+        clockSeconds -= 60;
+        clockMinutes++;
+        if (clockMinutes == 60) {
+            clockMinutes = CLEAR;
+            clockHour++;
+            rtcResyncDue = true; // Resync system clock from RTC each hour
+            if (clockHour == 24) {
+                clockHour = CLEAR;
+                clockDD++;
+                switch (clockMM) {
+                case 2:
+                    monthDays = (clockYY & 0x03) ? 28 : 29;
+                    break;
+                case 4:
+                case 6:
+                case 9:
+                case 11:
+                    monthDays = 30;
+                    break;
+                default:
+                    monthDays = 31;
+                    break;
+                }
+                if (clockDD > monthDays) {
+                    clockDD = 1;
+                    clockMM++;
+                    if (clockMM == 13) {
+                        clockMM = 1;
+                        clockYY++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*************************************************************************************************************************
+
+This function is called to load system clock from current time stamp.
+The purpose of this function is to resync system clock after time is read from or fed into RTC.
+
+ **************************************************************************************************************************/
+void setSystemClock(void) {
+    INTCONbits.GIEL = DISABLED; // Hold Timer0 interrupt while clock is loaded
+    clockSeconds = currentSeconds;
+    clockMinutes = currentMinutes;
+    clockHour = currentHour;
+    clockDD = currentDD;
+    clockMM = currentMM;
+    clockYY = currentYY;
+    rtcResyncDue = false;
+    systemClockSynced = true;
+    INTCONbits.GIEL = ENABLED;
+}
+
+/*************************************************************************************************************************
+
+This function is called to get current time stamp.
+The purpose of this function is to read time from system clock and to read RTC only at boot and each hour.
+If RTC fails, running system clock is kept and RTC is read again on next call.
+If RTC fails at boot, time is taken from network when GSM is set to local time.
+
+ **************************************************************************************************************************/
+void getCurrentTime(void) {
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("getCurrentTime_IN\r\n");
+    //********Debug log#end**************//
+#endif
+    if ((!systemClockSynced || rtcResyncDue) && fetchTimefromRTC()) {
+        setSystemClock();
+    }
+    else if (!systemClockSynced) {
+        setBCDdigit(0x0E,1); // (t) BCD indication for RTC Clock error
+        if (gsmSetToLocalTime) {
+            getDateFromGSM(); // Get today's date from Network, date is cleared if network time is not valid
+        }
+        if (currentMM != 0) {
+            setSystemClock();
+        }
+    #ifdef DEBUG_MODE_ON_H
+        //********Debug log#start************//
+        transmitStringToDebug("getCurrentTime_RtcFailed\r\n");
+        //********Debug log#end**************//
+    #endif
+    }
+    else {
+        INTCONbits.GIEL = DISABLED; // Hold Timer0 interrupt while clock is read
+        currentSeconds = clockSeconds;
+        currentMinutes = clockMinutes;
+        currentHour = clockHour;
+        currentDD = clockDD;
+        currentMM = clockMM;
+        currentYY = clockYY;
+        INTCONbits.GIEL = ENABLED;
+    }
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("getCurrentTime_OUT\r\n");
+    //********Debug log#end**************//
 #endif
 }
 
@@ -118,53 +264,169 @@ void fetchTimefromRTC(void) {
 
 /****************I2C-Library*******************/
 
-void i2cStart(void) {
-	SSP2CON2bits.SEN = 1;
-	//SSPCON2 bit 0
-	while (SSP2CON2bits.SEN == SET);
-	//SEN =1 initiate the Start Condition on SDA and SCL Pins
-	//Automatically Cleared by Hardware
-	// 0 for Idle State
+/*************************************************************************************************************************
+
+This function is called to queue I2C read or write transaction of given register of slave.
+The purpose of this function is to transfer bytes in background by MSSP interrupt.
+Given callback is called from interrupt on completion, data buffer must not be changed until then.
+It returns false if queue is full.
+
+ **************************************************************************************************************************/
+_Bool queueI2CTransaction(unsigned char slaveAddress, unsigned char registerAddress, unsigned char *data, unsigned char length, _Bool read, void (*callback)(_Bool)) {
+    struct I2CTRANSACTION *transaction;
+    INTCONbits.GIEL = DISABLED; // Hold low priority interrupt while queue is modified
+    if (i2cQueueCount == i2cQueueSize) {
+        INTCONbits.GIEL = ENABLED;
+        return false;
+    }
+    transaction = &i2cQueue[i2cQueueTail];
+    transaction->slaveAddress = slaveAddress;
+    transaction->registerAddress = registerAddress;
+    transaction->data = data;
+    transaction->length = length;
+    transaction->read = read;
+    transaction->callback = callback;
+    i2cQueueTail = (i2cQueueTail + 1) & (i2cQueueSize - 1);
+    i2cQueueCount++;
+    if (i2cState == i2cStateIdle) {
+        startI2CTransaction();
+    }
+    INTCONbits.GIEL = ENABLED;
+    return true;
 }
 
-void i2cRestart(void) {
-	SSP2CON2bits.RSEN = 1;
-	//SSPCON2 bit 1
-	while (SSP2CON2bits.RSEN == SET);
-	//RSEN = 1 initiate the Restart Condition
-	//Automatically Cleared by Hardware
+/*************************************************************************************************************************
+
+This function is called to start I2C transaction at head of queue.
+The purpose of this function is to initiate start condition, rest of transaction is followed in MSSP interrupt.
+
+ **************************************************************************************************************************/
+void startI2CTransaction(void) {
+    i2cIndex = CLEAR;
+    i2cTransactionFailed = false;
+    i2cState = i2cStateStart;
+    SSP2CON2bits.SEN = SET; // Initiate start condition
 }
 
-void i2cStop(void) {
-	SSP2CON2bits.PEN = 1;
-	while (SSP2CON2bits.PEN == SET);
+/*************************************************************************************************************************
+
+This function is called to terminate I2C transaction in progress with stop condition.
+The purpose of this function is to release bus after last byte or after slave did not acknowledge.
+
+ **************************************************************************************************************************/
+void stopI2CTransaction(_Bool failed) {
+    i2cTransactionFailed = failed;
+    i2cState = i2cStateStop;
+    SSP2CON2bits.PEN = SET; // Initiate stop condition
 }
 
-void i2cWait(void) {
-    while ((SSP2CON2 & 0x1F) | (SSP2STATbits.R_NOT_W));
-    // Wait condition until I2C bus is Idle.
+/*************************************************************************************************************************
+
+This function is called after stop condition of I2C transaction or after bus collision.
+The purpose of this function is to report completion to callback and to start next queued transaction.
+
+ **************************************************************************************************************************/
+void finishI2CTransaction(void) {
+    struct I2CTRANSACTION *transaction = &i2cQueue[i2cQueueHead];
+    i2cState = i2cStateIdle;
+    i2cQueueHead = (i2cQueueHead + 1) & (i2cQueueSize - 1);
+    i2cQueueCount--;
+    if (transaction->callback) {
+        transaction->callback(!i2cTransactionFailed);
+    }
+    if (i2cQueueCount > 0) {
+        startI2CTransaction();
+    }
 }
 
-void i2cSend(unsigned char dat) {
-	SSP2BUF = dat;    /* Move data to SSPBUF */
-    while (SSP2STATbits.BF);       /* wait till complete data is sent from buffer */
-    i2cWait();       /* wait for any pending transfer */
+/*************************************************************************************************************************
+
+This function is called from MSSP interrupt after each start, restart, stop, byte and acknowledge sequence.
+The purpose of this function is to follow I2C transaction by one step without waiting for bus.
+
+ **************************************************************************************************************************/
+void serviceI2CInterrupt(void) {
+    struct I2CTRANSACTION *transaction = &i2cQueue[i2cQueueHead];
+    switch (i2cState) {
+    case i2cStateStart:
+        SSP2BUF = transaction->slaveAddress; // Slave address with write mode
+        i2cState = i2cStateAddress;
+        break;
+    case i2cStateAddress:
+        if (SSP2CON2bits.ACKSTAT) {
+            stopI2CTransaction(true); // Slave not present
+        }
+        else {
+            SSP2BUF = transaction->registerAddress; // Address of register written to the pointer
+            i2cState = i2cStateRegister;
+        }
+        break;
+    case i2cStateRegister:
+    case i2cStateWrite:
+        if (SSP2CON2bits.ACKSTAT) {
+            stopI2CTransaction(true);
+        }
+        else if (transaction->read) {
+            SSP2CON2bits.RSEN = SET; // Initiate restart condition
+            i2cState = i2cStateRestart;
+        }
+        else if (i2cIndex < transaction->length) {
+            SSP2BUF = transaction->data[i2cIndex++];
+            i2cState = i2cStateWrite;
+        }
+        else {
+            stopI2CTransaction(false);
+        }
+        break;
+    case i2cStateRestart:
+        SSP2BUF = transaction->slaveAddress | 0x01; // Slave address with read mode
+        i2cState = i2cStateReadAddress;
+        break;
+    case i2cStateReadAddress:
+        if (SSP2CON2bits.ACKSTAT) {
+            stopI2CTransaction(true);
+        }
+        else {
+            SSP2CON2bits.RCEN = SET; // Enable data reception
+            i2cState = i2cStateReceive;
+        }
+        break;
+    case i2cStateReceive:
+        transaction->data[i2cIndex++] = SSP2BUF;
+        if (i2cIndex < transaction->length) {
+            SSP2CON2bits.ACKDT = 0; // Acknowledge
+        }
+        else {
+            SSP2CON2bits.ACKDT = 1; // Do not acknowledge last byte
+        }
+        SSP2CON2bits.ACKEN = SET;
+        i2cState = i2cStateAcknowledge;
+        break;
+    case i2cStateAcknowledge:
+        if (i2cIndex < transaction->length) {
+            SSP2CON2bits.RCEN = SET;
+            i2cState = i2cStateReceive;
+        }
+        else {
+            stopI2CTransaction(false);
+        }
+        break;
+    case i2cStateStop:
+        finishI2CTransaction();
+        break;
+    }
 }
 
-unsigned char i2cRead(_Bool ACK) {
-	unsigned char temp;
-    SSP2CON2bits.RCEN = 1;
-    /* Enable data reception */
-    while (SSP2STATbits.BF == CLEAR);      /* wait for buffer full */
-    temp = SSP2BUF;   /* Read serial buffer and store in temp register */
-    i2cWait();       /* wait to check any pending transfer */
-    if (ACK)
-        SSP2CON2bits.ACKDT=0;               //send acknowledge
-    else
-        SSP2CON2bits.ACKDT=1;				//Do not  acknowledge
-	SSP2CON2bits.ACKEN=1;
-	while (SSP2CON2bits.ACKEN == SET)
-        ;
-    return temp;     /* Return the read data from bus */
+/*************************************************************************************************************************
+
+This function is called from bus collision interrupt of MSSP.
+The purpose of this function is to abort I2C transaction in progress, MSSP returns to idle state after collision.
+
+ **************************************************************************************************************************/
+void abortI2CTransaction(void) {
+    if (i2cState != i2cStateIdle) {
+        i2cTransactionFailed = true;
+        finishI2CTransaction();
+    }
 }
-/**********************************************/
\ No newline at end of file
+/**********************************************/
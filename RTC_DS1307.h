@@ -12,16 +12,22 @@
 #define	RTC_DS1307_H
 
 /**********Function Prototypes**********/
-void i2cStart(void);
-void i2cRestart(void);
-void i2cStop(void);
-void i2cWait(void);
-void i2cSend(unsigned char);
-unsigned char i2cRead(_Bool);
-void fetchTimefromRTC(void);
+_Bool fetchTimefromRTC(void);
 unsigned char decimal2BCD (unsigned char);
 unsigned char bcd2Decimal (unsigned char bcd);
 void feedTimeInRTC(void);
+_Bool waitForRtcTransfer(void);             // Wait for RTC transfer with timeout
+void advanceSystemClock(unsigned char);     // Advance system clock by given seconds
+void setSystemClock(void);                  // Load system clock from current time stamp
+void getCurrentTime(void);                  // Read current time stamp from system clock
+void rtcTimeReceived(_Bool);
+void rtcTimeWritten(_Bool);
+_Bool queueI2CTransaction(unsigned char, unsigned char, unsigned char *, unsigned char, _Bool, void (*)(_Bool)); // Queue I2C transaction with completion callback
+void startI2CTransaction(void);
+void stopI2CTransaction(_Bool);
+void finishI2CTransaction(void);
+void serviceI2CInterrupt(void);             // Follow I2C transaction in MSSP interrupt
+void abortI2CTransaction(void);             // Abort I2C transaction on bus collision
 /************************************/
 #endif
  /* RTC_DS1307_H */
\ No newline at end of file
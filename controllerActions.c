@@ -15,6 +15,7 @@
 #include "eeprom.h"
 #include "gsm.h"
 #include "RTC_DS1307.h"
+#include "numberFormat.h"
 #ifdef Encryption_ON_H
 #include "dataEncryption.h"
 #endif
@@ -24,18 +25,22 @@
 /************************general purpose functions_start*******************************/
 /*************************************************************************************************************************
 
-This function is called to copy string from source to destination
-The purpose of this function is to copy string till it finds first \n character in source.
+This function is called to copy one line of message from source buffer at given offset to destination buffer
+The purpose of this function is to copy message till first \r or \n character or till length of source.
+Destination is terminated with null and its length is set, so it need not be cleared before copy.
 
  **************************************************************************************************************************/
 
-char *strcpyCustom(char *restrict dest, const char *restrict src) {
-	const char *s = src;
-	char *d = dest;
-	while ((*d++ = *s++))
-        if (*s == '\n' || *s == '\r' || *s == '\0')
-        break;
-	return dest;
+void copyMessageLine(struct MESSAGEBUFFER *dest, struct MESSAGEBUFFER *src, unsigned char offset) {
+    unsigned char index = CLEAR;
+    while (offset < src->length && index < dest->capacity - 1) {
+        if (src->data[offset] == '\n' || src->data[offset] == '\r' || src->data[offset] == '\0') {
+            break;
+        }
+        dest->data[index++] = src->data[offset++];
+    }
+    dest->data[index] = '\0';
+    dest->length = index;
 }
 //****************** 1 millisecond delay function_Start******************//
 
@@ -123,6 +128,7 @@ void getDateFromGSM(void) {
 #endif
     controllerCommandExecuted = false;
     msgIndex = CLEAR;
+    gsmResponseBuffer.length = CLEAR; // Length is set in RX interrupt when response is completed with OK
     T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 15 sec
     setBCDdigit(0x0B,1);  // (]) BCD indication for getDateFromGSM action
     while (!controllerCommandExecuted) {
@@ -145,14 +151,11 @@ void getDateFromGSM(void) {
     currentSeconds = CLEAR;
 
     
-    // To check no garbage value received for date time command
-    for (index = 8;index<22;index+=2)
+    // To check no garbage value received for date time command, stale text of previous response is not parsed after timeout
+    controllerCommandExecuted = (gsmResponseBuffer.length > 24);
+    for (index = 8; index < 24 && controllerCommandExecuted; index += 3)
     {
-        if (isNumber( gsmResponse[index]) && isNumber( gsmResponse[index+1]))
-        {
-           controllerCommandExecuted = true; 
-        }
-        else
+        if (!isNumber( gsmResponse[index]) || !isNumber( gsmResponse[index+1]))
         {
            controllerCommandExecuted = false; 
         }
@@ -220,9 +223,7 @@ void getDueDate(unsigned char days) {
     //********Debug log#end**************//
 #endif
     dueDD = CLEAR, dueMM = CLEAR, dueYY = CLEAR;
-    myMsDelay(100);
-    fetchTimefromRTC();
-    myMsDelay(100);
+    getCurrentTime();
     dueDD = currentDD; // get todays day and set as temporary  dueDD
     switch (currentMM - 1) {
     case 11:
@@ -345,9 +346,7 @@ void scanValveScheduleAndGetSleepCount(void) {
 			if (fieldValve[iterator].isConfigured && fieldValve[iterator].status != ON) {
 				//get current date only for one iteration
 				if (!currentDateCalled) {
-					myMsDelay(100);
-					fetchTimefromRTC(); // Get today's date
-					myMsDelay(100);
+					getCurrentTime(); // Get today's date
 					currentDateCalled = true; // Today's date is known
 					sleepCount = 65500; // Set Sleep count to default value until it is calculated
 				}
@@ -722,6 +721,459 @@ void fetchParallelValveList(unsigned char FieldNo) {
 
 /*************************************************************************************************************************
 
+This function is called to release given priority before it is configured again
+The purpose of this function is to erase configuration of valves set for given priority.
+Released valves are marked in valveCommitMask to be saved by commitConfiguredValves.
+
+ **************************************************************************************************************************/
+void releaseValvePriority(unsigned char priority) {
+    unsigned char field_No;
+    for (field_No = 0; field_No < fieldCount; field_No++) {
+        if (fieldValve[field_No].priority == priority) {
+            fieldValve[field_No].isConfigured = false;
+            fieldValve[field_No].priority = 0; // reset priority as well
+            valveCommitMask |= (unsigned int)1 << field_No;
+        }
+    }
+}
+
+/*************************************************************************************************************************
+
+This function is called to schedule newly configured valve
+The purpose of this function is to set due date of valve after given no. of days and to reset its status and fertigation settings.
+
+ **************************************************************************************************************************/
+void scheduleConfiguredValve(unsigned char field_No, unsigned char dayCount) {
+    getDueDate(dayCount); // Get due dates w.r.t triggered from date
+    fieldValve[field_No].nextDueDD = (unsigned char)dueDD;
+    fieldValve[field_No].nextDueMM = dueMM;
+    fieldValve[field_No].nextDueYY = dueYY;
+    fieldValve[field_No].status = OFF;
+    fieldValve[field_No].isConfigured = true;
+    fieldValve[field_No].fertigationDelay = 0;
+    fieldValve[field_No].fertigationONperiod = 0;
+    fieldValve[field_No].fertigationInstance = 0;
+    fieldValve[field_No].isFertigationEnabled = false;
+    fieldValve[field_No].fertigationStage = OFF;
+    fieldValve[field_No].fertigationValveInterrupted = false;
+}
+
+/*************************************************************************************************************************
+
+This function is called to save configuration of released and newly configured valves
+The purpose of this function is to commit all valves marked in valveCommitMask into EEPROM in one batch after whole command is applied.
+
+ **************************************************************************************************************************/
+void commitConfiguredValves(void) {
+    unsigned char field_No;
+    for (field_No = 0; field_No < fieldCount; field_No++) {
+        if (valveCommitMask & ((unsigned int)1 << field_No)) {
+            commitIrrigationValveConfigurationIntoEeprom(eepromAddress[field_No], &fieldValve[field_No]);
+        }
+    }
+    valveCommitMask = CLEAR;
+}
+
+/*************************************************************************************************************************
+
+This function is called to calculate CRC of configuration snapshot
+The purpose of this function is to return CRC-16/CCITT of given bytes to detect corrupted or incomplete snapshot.
+
+ **************************************************************************************************************************/
+unsigned int getSnapshotCrc(const unsigned char *data, unsigned int length) {
+    unsigned int crc = 0xFFFF;
+    unsigned char bit;
+    while (length--) {
+        crc ^= (unsigned int)*data++ << 8;
+        for (bit = 0; bit < 8; bit++) {
+            if (crc & 0x8000) {
+                crc = (crc << 1) ^ 0x1021;
+            }
+            else {
+                crc = crc << 1;
+            }
+        }
+    }
+    return crc;
+}
+
+/*************************************************************************************************************************
+
+This function is called to build configuration snapshot of controller
+The purpose of this function is to pack valve table, filtration sequence and motor load cut-offs into snapshotImage.
+False is returned if configuration does not fit in snapshot image.
+
+ **************************************************************************************************************************/
+_Bool buildConfigurationSnapshot(void) {
+    const struct INJECTORPROGRAM *programptr;
+    unsigned int index = snapshotHeaderSize;
+    unsigned int fieldMask = CLEAR;
+    unsigned int crc;
+    unsigned char field_No;
+    unsigned char injector;
+    snapshotPart = CLEAR; // Discard RESTORE parts received so far
+    for (field_No = 0; field_No < fieldCount; field_No++) {
+        if (!fieldValve[field_No].isConfigured) {
+            continue;
+        }
+        if (index + snapshotValveRecordSize + (fieldValve[field_No].isFertigationEnabled ? snapshotFertigationRecordSize : 0) + snapshotSystemRecordSize + snapshotCrcSize > snapshotImageSize) {
+            snapshotLength = CLEAR;
+            return false;
+        }
+        fieldMask |= (unsigned int)(0x800 >> field_No);
+        snapshotImage[index++] = fieldValve[field_No].priority | (fieldValve[field_No].isFertigationEnabled ? 0x80 : 0);
+        snapshotImage[index++] = (unsigned char)(fieldValve[field_No].onPeriod >> 8);
+        snapshotImage[index++] = (unsigned char)fieldValve[field_No].onPeriod;
+        snapshotImage[index++] = fieldValve[field_No].offPeriod;
+        snapshotImage[index++] = fieldValve[field_No].motorOnTimeHour;
+        snapshotImage[index++] = fieldValve[field_No].motorOnTimeMinute;
+        snapshotImage[index++] = (unsigned char)(fieldValve[field_No].dryValue >> 8);
+        snapshotImage[index++] = (unsigned char)fieldValve[field_No].dryValue;
+        snapshotImage[index++] = (unsigned char)(fieldValve[field_No].wetValue >> 8);
+        snapshotImage[index++] = (unsigned char)fieldValve[field_No].wetValue;
+        snapshotImage[index++] = fieldValve[field_No].cycles;
+        snapshotImage[index++] = fieldValve[field_No].cyclesExecuted;
+        snapshotImage[index++] = fieldValve[field_No].nextDueDD;
+        snapshotImage[index++] = fieldValve[field_No].nextDueMM;
+        snapshotImage[index++] = fieldValve[field_No].nextDueYY;
+        if (fieldValve[field_No].isFertigationEnabled) {
+            programptr = getInjectorProgram(&fieldValve[field_No]);
+            snapshotImage[index++] = (unsigned char)(fieldValve[field_No].fertigationDelay >> 8);
+            snapshotImage[index++] = (unsigned char)fieldValve[field_No].fertigationDelay;
+            snapshotImage[index++] = (unsigned char)(fieldValve[field_No].fertigationONperiod >> 8);
+            snapshotImage[index++] = (unsigned char)fieldValve[field_No].fertigationONperiod;
+            snapshotImage[index++] = fieldValve[field_No].fertigationInstance;
+            for (injector = 0; injector < 4; injector++) {
+                snapshotImage[index++] = (unsigned char)(programptr->onPeriod[injector] >> 8);
+                snapshotImage[index++] = (unsigned char)programptr->onPeriod[injector];
+            }
+            for (injector = 0; injector < 4; injector++) {
+                snapshotImage[index++] = (unsigned char)(programptr->offPeriod[injector] >> 8);
+                snapshotImage[index++] = (unsigned char)programptr->offPeriod[injector];
+            }
+            for (injector = 0; injector < 4; injector++) {
+                snapshotImage[index++] = programptr->cycle[injector];
+            }
+        }
+    }
+    snapshotImage[index++] = filtrationDelay1;
+    snapshotImage[index++] = filtrationDelay2;
+    snapshotImage[index++] = filtrationDelay3;
+    snapshotImage[index++] = filtrationOnTime;
+    snapshotImage[index++] = (unsigned char)(filtrationSeperationTime >> 8);
+    snapshotImage[index++] = (unsigned char)filtrationSeperationTime;
+    snapshotImage[index++] = filtrationEnabled;
+    snapshotImage[index++] = (unsigned char)(noLoadCutOff >> 8);
+    snapshotImage[index++] = (unsigned char)noLoadCutOff;
+    snapshotImage[index++] = (unsigned char)(fullLoadCutOff >> 8);
+    snapshotImage[index++] = (unsigned char)fullLoadCutOff;
+    // Fill header and append CRC
+    snapshotImage[0] = snapshotVersion;
+    snapshotImage[1] = (unsigned char)((index + snapshotCrcSize) >> 8);
+    snapshotImage[2] = (unsigned char)(index + snapshotCrcSize);
+    snapshotImage[3] = (unsigned char)(fieldMask >> 8);
+    snapshotImage[4] = (unsigned char)fieldMask;
+    crc = getSnapshotCrc(snapshotImage, index);
+    snapshotImage[index++] = (unsigned char)(crc >> 8);
+    snapshotImage[index++] = (unsigned char)crc;
+    snapshotLength = index;
+    return true;
+}
+
+/*************************************************************************************************************************
+
+This function is called to append base64 text of RESTORE part to configuration snapshot being received
+The purpose of this function is to decode base64 characters of decodedString from given index into snapshotImage.
+False is returned if part holds other than base64 characters or does not fit in snapshot image.
+
+ **************************************************************************************************************************/
+_Bool decodeSnapshotPart(unsigned char index) {
+    unsigned long bits = CLEAR; // Bits pending to be stored as bytes
+    unsigned char bitCount = CLEAR;
+    unsigned char character;
+    for (; index < decodedStringBuffer.length && decodedString[index] != '='; index++) {
+        character = decodedString[index];
+        if (character >= 'A' && character <= 'Z') {
+            character = character - 'A';
+        }
+        else if (character >= 'a' && character <= 'z') {
+            character = character - 'a' + 26;
+        }
+        else if (isNumber(character)) {
+            character = character - '0' + 52;
+        }
+        else if (character == '+') {
+            character = 62;
+        }
+        else if (character == '/') {
+            character = 63;
+        }
+        else {
+            return false;
+        }
+        bits = (bits << 6) | character;
+        bitCount += 6;
+        if (bitCount >= 8) {
+            bitCount -= 8;
+            if (snapshotLength == snapshotImageSize) {
+                return false;
+            }
+            snapshotImage[snapshotLength++] = (unsigned char)(bits >> bitCount);
+        }
+    }
+    return true;
+}
+
+/*************************************************************************************************************************
+
+This function is called to restore configuration snapshot after all RESTORE parts are received
+The purpose of this function is to verify snapshotImage completely before any setting is changed
+and then to apply valve table, filtration sequence and motor load cut-offs and save them into EEPROM.
+Each valve record is checked for priority and motor on time in range before any record is applied.
+False is returned and configuration is left unchanged if image is corrupted.
+
+ **************************************************************************************************************************/
+_Bool applyConfigurationSnapshot(void) {
+    struct INJECTORPROGRAM program;
+    const unsigned char *record;
+    unsigned int index;
+    unsigned int fieldMask;
+    unsigned char field_No;
+    unsigned char injector;
+    // Verify image
+    if (snapshotLength < snapshotHeaderSize + snapshotSystemRecordSize + snapshotCrcSize || snapshotImage[0] != snapshotVersion
+            || getSnapshotCrc(snapshotImage, snapshotLength - snapshotCrcSize) != (((unsigned int)snapshotImage[snapshotLength - 2] << 8) | snapshotImage[snapshotLength - 1])) {
+        return false;
+    }
+    fieldMask = ((unsigned int)snapshotImage[3] << 8) | snapshotImage[4];
+    for (field_No = 0, index = snapshotHeaderSize; field_No < fieldCount; field_No++) {
+        if (fieldMask & (0x800 >> field_No)) {
+            record = snapshotImage + index;
+            index += (record[0] & 0x80) ? snapshotValveRecordSize + snapshotFertigationRecordSize : snapshotValveRecordSize;
+            if (index + snapshotSystemRecordSize + snapshotCrcSize > snapshotLength) {
+                return false;
+            }
+            // Priority 1 to 12, motor on time and due date in range
+            if ((record[0] & 0x7F) == 0 || (record[0] & 0x7F) > fieldCount || record[4] > 23 || record[5] > 59
+                    || record[12] > 31 || record[13] > 12) {
+                return false;
+            }
+        }
+    }
+    if (index + snapshotSystemRecordSize + snapshotCrcSize != snapshotLength) {
+        return false;
+    }
+    // Release injector programs so that they are assigned again as per snapshot
+    for (field_No = 0; field_No < fieldCount; field_No++) {
+        fieldValve[field_No].isFertigationEnabled = false;
+        fieldValve[field_No].injectorSlot = noInjectorProgram;
+    }
+    // Apply valve table
+    for (field_No = 0, index = snapshotHeaderSize; field_No < fieldCount; field_No++) {
+        fieldValve[field_No].status = OFF;
+        fieldValve[field_No].fertigationStage = OFF;
+        fieldValve[field_No].fertigationValveInterrupted = false;
+        fieldValve[field_No].fertigationDelay = 0;
+        fieldValve[field_No].fertigationONperiod = 0;
+        fieldValve[field_No].fertigationInstance = 0;
+        valveCommitMask |= (unsigned int)1 << field_No;
+        if (!(fieldMask & (0x800 >> field_No))) {
+            fieldValve[field_No].isConfigured = false;
+            fieldValve[field_No].priority = 0;
+            continue;
+        }
+        record = snapshotImage + index;
+        fieldValve[field_No].priority = record[0] & 0x7F;
+        fieldValve[field_No].onPeriod = ((unsigned int)record[1] << 8) | record[2];
+        fieldValve[field_No].offPeriod = record[3];
+        fieldValve[field_No].motorOnTimeHour = record[4];
+        fieldValve[field_No].motorOnTimeMinute = record[5];
+        fieldValve[field_No].dryValue = ((unsigned int)record[6] << 8) | record[7];
+        fieldValve[field_No].wetValue = ((unsigned int)record[8] << 8) | record[9];
+        fieldValve[field_No].wetValuePeriod = getMoisturePeriod(fieldValve[field_No].wetValue);
+        fieldValve[field_No].cycles = record[10];
+        fieldValve[field_No].cyclesExecuted = record[11];
+        fieldValve[field_No].nextDueDD = record[12];
+        fieldValve[field_No].nextDueMM = record[13];
+        fieldValve[field_No].nextDueYY = record[14];
+        fieldValve[field_No].isConfigured = true;
+        index += snapshotValveRecordSize;
+        if (record[0] & 0x80) {
+            record = snapshotImage + index;
+            fieldValve[field_No].fertigationDelay = ((unsigned int)record[0] << 8) | record[1];
+            fieldValve[field_No].fertigationONperiod = ((unsigned int)record[2] << 8) | record[3];
+            fieldValve[field_No].fertigationInstance = record[4];
+            for (injector = 0; injector < 4; injector++) {
+                program.onPeriod[injector] = ((unsigned int)record[5 + (injector << 1)] << 8) | record[6 + (injector << 1)];
+                program.offPeriod[injector] = ((unsigned int)record[13 + (injector << 1)] << 8) | record[14 + (injector << 1)];
+                program.cycle[injector] = record[21 + injector];
+            }
+            fieldValve[field_No].isFertigationEnabled = assignInjectorProgram(&fieldValve[field_No], &program);
+            index += snapshotFertigationRecordSize;
+        }
+    }
+    // Apply filtration sequence and motor load cut-offs
+    record = snapshotImage + index;
+    filtrationDelay1 = record[0];
+    filtrationDelay2 = record[1];
+    filtrationDelay3 = record[2];
+    filtrationOnTime = record[3];
+    filtrationSeperationTime = ((unsigned int)record[4] << 8) | record[5];
+    filtrationEnabled = record[6] ? true : false;
+    noLoadCutOff = ((unsigned int)record[7] << 8) | record[8];
+    fullLoadCutOff = ((unsigned int)record[9] << 8) | record[10];
+    commitConfiguredValves();
+    saveFiltrationSequenceData();
+    saveMotorLoadValuesIntoEeprom();
+    return true;
+}
+
+/*************************************************************************************************************************
+
+This function is called to preview valve actions of given no. of days
+The purpose of this function is to copy valve table into planValve and to simulate schedule forward from current time into planEvent.
+Valve in action is listed as first action with its remaining on period and simulation starts at its end.
+Field valve table is not changed. Day count is 1 to planMaxDays.
+
+ **************************************************************************************************************************/
+void planValveSchedule(unsigned char dayCount) {
+    unsigned char field_No;
+    unsigned int startMinute;
+    unsigned int runningMask = CLEAR;
+    unsigned int remainingPeriod = CLEAR;
+    unsigned char runningCount = CLEAR;
+    getCurrentTime(); // Get today's date
+    planStartDay = getPlanDayNumber(currentDD, currentMM, currentYY);
+    startMinute = ((unsigned int)currentHour * 60) + currentMinutes;
+    for (field_No = 0; field_No < fieldCount; field_No++) {
+        planValve[field_No].priority = fieldValve[field_No].priority;
+        planValve[field_No].isConfigured = fieldValve[field_No].isConfigured;
+        planValve[field_No].isFertigationEnabled = fieldValve[field_No].isFertigationEnabled;
+        planValve[field_No].cycles = fieldValve[field_No].cycles;
+        planValve[field_No].cyclesExecuted = fieldValve[field_No].cyclesExecuted;
+        planValve[field_No].offPeriod = fieldValve[field_No].offPeriod;
+        planValve[field_No].fertigationInstance = fieldValve[field_No].fertigationInstance;
+        planValve[field_No].motorOnMinute = ((unsigned int)fieldValve[field_No].motorOnTimeHour * 60) + fieldValve[field_No].motorOnTimeMinute;
+        planValve[field_No].onPeriod = fieldValve[field_No].onPeriod;
+        planValve[field_No].dueDay = (int)(getPlanDayNumber(fieldValve[field_No].nextDueDD, fieldValve[field_No].nextDueMM, fieldValve[field_No].nextDueYY) - planStartDay);
+        // Complete cycle of valve in action as in actionsOnSleepCountFinish
+        if (fieldValve[field_No].status == ON) {
+            // Remaining on period is sleep count of current stage and periods of later fertigation stages
+            if (runningMask == CLEAR) {
+                remainingPeriod = sleepCount;
+                if (fieldValve[field_No].fertigationStage == wetPeriod) {
+                    remainingPeriod += fieldValve[field_No].onPeriod - fieldValve[field_No].fertigationDelay;
+                }
+                else if (fieldValve[field_No].fertigationStage == injectPeriod) {
+                    remainingPeriod += fieldValve[field_No].onPeriod - (fieldValve[field_No].fertigationDelay + fieldValve[field_No].fertigationONperiod);
+                }
+                if (remainingPeriod > fieldValve[field_No].onPeriod) {
+                    remainingPeriod = fieldValve[field_No].onPeriod; // Sleep count is not on period while motor is held
+                }
+                if (fieldValve[field_No].fertigationStage != OFF) {
+                    runningMask = planFertigationFlag;
+                }
+            }
+            runningMask |= 1U << field_No;
+            if (planValve[field_No].cyclesExecuted == planValve[field_No].cycles) {
+                planValve[field_No].cyclesExecuted = 1;
+            }
+            else {
+                planValve[field_No].cyclesExecuted++;
+            }
+        }
+    }
+    if (runningMask != CLEAR) {
+        planEvent[0].startMinute = startMinute;
+        planEvent[0].fieldMask = runningMask;
+        planEvent[0].duration = remainingPeriod;
+        runningCount = 1;
+    }
+    planEventTotal = runningCount + runSchedulePlan(planValve, fieldCount, nxtPriority, startMinute + remainingPeriod, startMinute + ((unsigned int)dayCount * planMinutesOfDay), planEvent + runningCount, planEventCount - runningCount);
+}
+
+#ifdef BINARY_SMS_ON_H
+/*************************************************************************************************************************
+
+This function is called to execute binary frame received from user
+The purpose of this function is to act on frame copied into decodedString and to reply with binary frame.
+Values of frame are used as received, no base64 decoding or number parsing is needed.
+
+ **************************************************************************************************************************/
+void extractBinaryCommand(void) {
+    unsigned char frameType = decodedString[0];
+    unsigned char recordCount = CLEAR;
+    unsigned char index;
+    unsigned char field_No;
+    unsigned char priority;
+    unsigned int fieldMask;
+    const unsigned char *record;
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("extractBinaryCommand_IN\r\n");
+    //********Debug log#end**************//
+#endif
+    if (frameType == binarySetFrame) {
+        for (index = 1; index + binaryValveRecordSize <= decodedStringBuffer.length; index += binaryValveRecordSize) {
+            record = decodedString + index;
+            priority = record[0];
+            fieldMask = ((unsigned int)record[12] << 8) | record[13];
+            if (priority == 0 || priority > fieldCount) {
+                continue; // skip record with invalid priority
+            }
+            releaseValvePriority(priority);
+            for (field_No = 0; field_No < fieldCount; field_No++) {
+                if (!(fieldMask & (0x800 >> field_No))) {
+                    continue;
+                }
+                fieldValve[field_No].onPeriod = ((unsigned int)record[1] << 8) | record[2];
+                fieldValve[field_No].offPeriod = record[3];
+                fieldValve[field_No].motorOnTimeHour = record[4];
+                fieldValve[field_No].motorOnTimeMinute = record[5];
+                fieldValve[field_No].dryValue = ((unsigned int)record[6] << 8) | record[7];
+                fieldValve[field_No].wetValue = ((unsigned int)record[8] << 8) | record[9];
+                fieldValve[field_No].wetValuePeriod = getMoisturePeriod(fieldValve[field_No].wetValue);
+                fieldValve[field_No].priority = priority;
+                fieldValve[field_No].cycles = record[10];
+                fieldValve[field_No].cyclesExecuted = record[10];
+                scheduleConfiguredValve(field_No, record[11]);
+                valveCommitMask |= (unsigned int)1 << field_No;
+            }
+            recordCount++;
+        }
+        commitConfiguredValves();
+    }
+    // Compose reply frame
+    gsmResponseBuffer.capacity = smsReplyOffset; // Keep received URC clear of reply buffer
+    smsReplyBuffer.length = CLEAR;
+    smsReplyPosition = CLEAR;
+    if (frameType == binaryStatusFrame || frameType == binarySetFrame) {
+        frameType |= binaryReplyFrame;
+        appendNumberToReply(&frameType, 1);
+        if (frameType == (binaryStatusFrame | binaryReplyFrame)) {
+            appendValveStatusToReply(8);
+        }
+        else {
+            appendNumberToReply(&recordCount, 1);
+        }
+    }
+    else {
+        frameType = binaryUnknownFrame;
+        appendNumberToReply(&frameType, 1);
+    }
+    /***************************/
+    sendBinarySms(userMobileNo);
+    /***************************/
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("extractBinaryCommand_OUT\r\n");
+    //********Debug log#end**************//
+#endif
+}
+#endif
+
+/*************************************************************************************************************************
+
 This function is called to extract received message after new message notification is received.
 The purpose of this function is to read sms received at 1st SIM memory location.
 The Action is decided upon Type of message received.
@@ -729,7 +1181,10 @@ The Action is decided upon Type of message received.
  **************************************************************************************************************************/
 void extractReceivedSms(void) {
     unsigned char count = CLEAR, onHour = CLEAR, onMinute = CLEAR, fetchedPriority = CLEAR;
+    unsigned char blockCount = CLEAR, blockLength = CLEAR, messageLength = CLEAR;
+    unsigned char smsType = CLEAR;
     unsigned int digit = CLEAR;
+    struct INJECTORPROGRAM program; // Injector program received in fertigation enable command
     timer3Count = 30; // 30 sec window
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
@@ -738,43 +1193,39 @@ void extractReceivedSms(void) {
 #endif
     // check for valid sim storage location
     if (temporaryBytesArray[0] > '0' && temporaryBytesArray[0] <= '9') {
-        controllerCommandExecuted = false;
-        msgIndex = CLEAR;
-        T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 15 sec
-        setBCDdigit(0x03,1);  // (3) BCD indication for Read Sms Action
-        while (!controllerCommandExecuted) {
-            transmitStringToGSM("AT+CMGR=");
-            transmitNumberToGSM(temporaryBytesArray, 1);
-            transmitStringToGSM("\r\n"); // reading msg from sim location
-            myMsDelay(500);
-            if (!controllerCommandExecuted) {
-                myMsDelay(5000);
+        smsType = readReceivedSms(); // SMS is read once, sender no. is saved as temp user
+    #ifdef BINARY_SMS_ON_H
+        // Execute binary frame received in 8 bit SMS from registered user, SMS of other senders is ignored
+        if (smsType == receivedSmsBinary) {
+            if (systemAuthenticated && strncmp(userMobileNo, temporaryBytesArray, 10) == 0) {
+                extractBinaryCommand();
             }
+            strncpy(temporaryBytesArray, null, 10);
+        #ifdef DEBUG_MODE_ON_H
+            //********Debug log#start************//
+            transmitStringToDebug("extractReceivedSms_BinaryFrame_OUT\r\n");
+            //********Debug log#end**************//
+        #endif
+            return;
         }
-        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-        PIR5bits.TMR3IF = SET; //Stop timer thread  
+    #endif
         // ADD indication if infinite
-        if(strncmp(gsmResponse+21, countryCode, 3) == 0) {
-            strncpy(temporaryBytesArray, gsmResponse + 24, 10); // Save received sender no. as temp user
-            clearStringToDecode();
+        if (smsType == receivedSmsText) {
             /*Decode received  Base64 format message*/
         #ifdef Encryption_ON_H
-            strcpyCustom((char *)stringToDecode,(const char *)gsmResponse + 63);
+            copyMessageLine(&stringToDecodeBuffer, &gsmResponseBuffer, 0); // SMS text is moved in place to start of gsmResponse
         #ifdef DEBUG_MODE_ON_H
             //********Debug log#start************//
-            transmitStringToDebug((const char *)gsmResponse + 63);
-            transmitStringToDebug("\r\n");
             transmitStringToDebug((char *)stringToDecode);
             transmitStringToDebug("\r\n");
             //********Debug log#end**************//
         #endif
-            clearGsmResponse();
-            if (isBase64String((unsigned char *)stringToDecode)) {
-                clearDecodedString();
+            if ((stringToDecodeBuffer.length & 0x03) == 0 && isBase64String((unsigned char *)stringToDecode)) {
                 base64Decoder();
+                clearGsmResponse(); // SMS text is decoded, gsmResponse is free for reply
             }
             else {
-                //clearGsmResponse();
+                clearGsmResponse();
                 setBCDdigit(0x05,0);  // (5.) BCD indication for Incorrect SMS format
                 myMsDelay(2000);
                 /***************************/ 
@@ -788,7 +1239,7 @@ void extractReceivedSms(void) {
         #endif
            
         #ifndef Encryption_ON_H
-            strcpyCustom((char *)decodedString,(const char *)gsmResponse + 63); // w/o encoder
+            copyMessageLine(&decodedStringBuffer, &gsmResponseBuffer, 0); // w/o encoder
         #endif
             //......Types of Message Received from Registered User.........//
             if (strncmp(userMobileNo, temporaryBytesArray, 10) == 0) {
@@ -799,13 +1250,6 @@ void extractReceivedSms(void) {
                     msgIndex = CLEAR;
                     /***************************/                
                     sendSms(SmsConnect, userMobileNo, noInfo);
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/
                 #ifdef DEBUG_MODE_ON_H
                     //********Debug log#start************//
@@ -823,13 +1267,6 @@ void extractReceivedSms(void) {
                         msgIndex = CLEAR;
                         /***************************/                  
                         sendSms(SmsPwd1, userMobileNo, noInfo);
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/
                     #ifdef DEBUG_MODE_ON_H
                         //********Debug log#start************//
@@ -842,13 +1279,6 @@ void extractReceivedSms(void) {
                         msgIndex = CLEAR;
                         /***************************/
                         sendSms(SmsPwd3, userMobileNo, noInfo);
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/ 
                     #ifdef DEBUG_MODE_ON_H
                         //********Debug log#start************//
@@ -861,144 +1291,123 @@ void extractReceivedSms(void) {
                 //#4>..............Save New Configured values of Field Valve X .................//
                     //Msg Format---------***SET<FieldNo.><Space><OnPeriod><Space><OffPeriod><Space><MotorOnTimeHr><Space><MotorOnTimeMins><Space><SensorDryValue><Space><SensorWetValue><Space>***------------//
                     //SMS Location---------63--------<72/73>------<74>-----------<77/78>---------<79/80/81>-------------//
+                    //Bulk Msg Format----***SET<Priority><Space>...<DayCount>;SET<Priority><Space>...<DayCount>***------------//
 
                 else if (strncmp(decodedString, set, 3) == 0) {
-                    digit = CLEAR;
-                    count = CLEAR; //count to extract onperiod, offperiod,motorOnHour,motorOnMinute,DryValue, wetValue; i.e total 9 attributes
-                    fetchedPriority = fetchFieldNo(3) + 1;   // fetch priority and add 1 for 1-12 range
-                    // Erase existing valve details for fetched priority
-                    for (iterator = 0; iterator < fieldCount; iterator++) {
-                        if (fieldValve[iterator].priority == fetchedPriority) {
-                            fieldValve[iterator].isConfigured = false;
-                            fieldValve[iterator].priority = 0; // reset priority as well
-                            saveIrrigationValvePriorityIntoEeprom(eepromAddress[iterator], &fieldValve[iterator]);
-                            myMsDelay(100);
-                            saveIrrigationValveConfigurationStatusIntoEeprom(eepromAddress[iterator], &fieldValve[iterator]);
-                            myMsDelay(100);
-                        }
-                    }
-                    for (iterator = 0; iterator < 20; iterator++)
-                        temporaryBytesArray[iterator] = 255;    // blank list
+                    blockCount = CLEAR;
+                    // Apply each priority block of bulk configuration in RAM, blocks are separated by bulkBlockSeparator
+                    do {
+                        for (blockLength = 0; blockLength < decodedStringBuffer.length && decodedString[blockLength] != bulkBlockSeparator; blockLength++);
+                        messageLength = decodedStringBuffer.length;
+                        decodedStringBuffer.length = blockLength; // Limit parsing to current block
+                        digit = CLEAR;
+                        count = CLEAR; //count to extract onperiod, offperiod,motorOnHour,motorOnMinute,DryValue, wetValue; i.e total 9 attributes
+                        fetchedPriority = fetchFieldNo(3) + 1;   // fetch priority and add 1 for 1-12 range
+                        releaseValvePriority(fetchedPriority); // Erase existing valve details for fetched priority
+                        for (iterator = 0; iterator < 20; iterator++)
+                            temporaryBytesArray[iterator] = 255;    // blank list
                     
-                    // fetch valve list to be configured for fetched priority
-                    for (count = 0, msgIndex = 5; count < 7; msgIndex++) {
-                        if (decodedString[msgIndex] == space) {
-                            count++;
-                            if (count == 7) {
-                                for (iterator = 0 ; decodedString[msgIndex+1]!= space; iterator++) {
-                                    temporaryBytesArray[iterator] = fetchFieldNo(msgIndex+1);
-                                    msgIndex = msgIndex+2;
+                        // fetch valve list to be configured for fetched priority
+                        for (count = 0, msgIndex = 5; count < 7 && msgIndex < decodedStringBuffer.length; msgIndex++) {
+                            if (decodedString[msgIndex] == space) {
+                                count++;
+                                if (count == 7) {
+                                    for (iterator = 0 ; msgIndex + 1 < decodedStringBuffer.length && decodedString[msgIndex+1]!= space; iterator++) {
+                                        temporaryBytesArray[iterator] = fetchFieldNo(msgIndex+1);
+                                        msgIndex = msgIndex+2;
+                                    }
                                 }
                             }
                         }
-                    }
-                    for (iterator = 0; temporaryBytesArray[iterator] != 255; iterator++) {
-                        for (count = 1, msgIndex = 6; count <= 9 ; msgIndex++) {
-                            //is number
-                            if (isNumber(decodedString[msgIndex])) {
-                                if (count != 7 ) { // skip priority 
-                                    if (decodedString[msgIndex + 1] == space) {
-                                        temp = decodedString[msgIndex] - 48;
-										digit = digit + temp;
-                                    } 
-                                    else {
-                                        temp = decodedString[msgIndex] - 48;
-                                        temp = temp * 10;
-                                        digit = digit * 10;
-                                        digit = digit + temp;
+                        for (iterator = 0; temporaryBytesArray[iterator] != 255; iterator++) {
+                            for (count = 1, msgIndex = 6; count <= 9 ; msgIndex++) {
+                                //is number
+                                if (isNumber(decodedString[msgIndex])) {
+                                    if (count != 7 ) { // skip priority 
+                                        if (decodedString[msgIndex + 1] == space) {
+                                            temp = decodedString[msgIndex] - 48;
+                                            digit = digit + temp;
+                                        } 
+                                        else {
+                                            temp = decodedString[msgIndex] - 48;
+                                            temp = temp * 10;
+                                            digit = digit * 10;
+                                            digit = digit + temp;
+                                        }
+                                    }   
+                                } 
+                                else {
+                                    switch (count) {
+                                    case 1: // code to extract on period;
+                                        fieldValve[temporaryBytesArray[iterator]].onPeriod = digit;
+                                        digit = CLEAR;
+                                        break;
+                                    case 2: // code to extract off period;
+                                        fieldValve[temporaryBytesArray[iterator]].offPeriod = (unsigned char)digit;
+                                        digit = CLEAR;
+                                        break;
+                                    case 3: // code to extract motorOnTimeHour;
+                                        fieldValve[temporaryBytesArray[iterator]].motorOnTimeHour = (unsigned char)digit;
+                                        digit = CLEAR;
+                                        break;
+                                    case 4: // code to extract motorOnTimeMinute;
+                                        fieldValve[temporaryBytesArray[iterator]].motorOnTimeMinute = (unsigned char)digit;
+                                        digit = CLEAR;
+                                        break;
+                                    case 5: // code to extract dryValue
+                                        fieldValve[temporaryBytesArray[iterator]].dryValue = digit;
+                                        digit = CLEAR;
+                                        break;
+                                    case 6: // code to extract wetValue
+                                        fieldValve[temporaryBytesArray[iterator]].wetValue = digit;
+                                        fieldValve[temporaryBytesArray[iterator]].wetValuePeriod = getMoisturePeriod(digit);
+                                        digit = CLEAR;
+                                        break;
+                                    case 7: // code to extract priority
+                                        fieldValve[temporaryBytesArray[iterator]].priority = fetchedPriority;
+                                        digit = CLEAR;
+                                        break;
+                                    case 8: // code to extract cycles
+                                        fieldValve[temporaryBytesArray[iterator]].cycles = (unsigned char)digit;
+                                        fieldValve[temporaryBytesArray[iterator]].cyclesExecuted = (unsigned char)digit;
+                                        digit = CLEAR;
+                                        break;    
+                                    case 9: // code to extract day count;
+                                        scheduleConfiguredValve(temporaryBytesArray[iterator], (unsigned char)digit);
+                                        digit = CLEAR;
+                                        break;
                                     }
-                                }   
-                            } 
-                            else {
-                                switch (count) {
-                                case 1: // code to extract on period;
-                                    fieldValve[temporaryBytesArray[iterator]].onPeriod = digit;
-                                    digit = CLEAR;
-                                    break;
-                                case 2: // code to extract off period;
-                                    fieldValve[temporaryBytesArray[iterator]].offPeriod = (unsigned char)digit;
-                                    digit = CLEAR;
-                                    break;
-                                case 3: // code to extract motorOnTimeHour;
-                                    fieldValve[temporaryBytesArray[iterator]].motorOnTimeHour = (unsigned char)digit;
-                                    digit = CLEAR;
-                                    break;
-                                case 4: // code to extract motorOnTimeMinute;
-                                    fieldValve[temporaryBytesArray[iterator]].motorOnTimeMinute = (unsigned char)digit;
-                                    digit = CLEAR;
-                                    break;
-                                case 5: // code to extract dryValue
-                                    fieldValve[temporaryBytesArray[iterator]].dryValue = digit;
-                                    digit = CLEAR;
-                                    break;
-                                case 6: // code to extract wetValue
-                                    fieldValve[temporaryBytesArray[iterator]].wetValue = digit;
-                                    digit = CLEAR;
-                                    break;
-                                case 7: // code to extract priority
-                                    fieldValve[temporaryBytesArray[iterator]].priority = fetchedPriority;
-                                    digit = CLEAR;
-                                    break;
-                                case 8: // code to extract cycles
-                                    fieldValve[temporaryBytesArray[iterator]].cycles = (unsigned char)digit;
-                                    fieldValve[temporaryBytesArray[iterator]].cyclesExecuted = (unsigned char)digit;
-                                    digit = CLEAR;
-                                    break;    
-                                case 9: // code to extract day count;
-                                    getDueDate((unsigned char)digit); // Get due dates w.r.t triggered from date
-                                    digit = CLEAR;
-                                    fieldValve[temporaryBytesArray[iterator]].nextDueDD = (unsigned char)dueDD;
-                                    fieldValve[temporaryBytesArray[iterator]].nextDueMM = dueMM;
-                                    fieldValve[temporaryBytesArray[iterator]].nextDueYY = dueYY;
-                                    fieldValve[temporaryBytesArray[iterator]].status = OFF;
-                                    fieldValve[temporaryBytesArray[iterator]].isConfigured = true;
-                                    fieldValve[temporaryBytesArray[iterator]].fertigationDelay = 0;
-                                    fieldValve[temporaryBytesArray[iterator]].fertigationONperiod = 0;
-                                    fieldValve[temporaryBytesArray[iterator]].fertigationInstance = 0;
-                                    fieldValve[temporaryBytesArray[iterator]].isFertigationEnabled = false;
-                                    fieldValve[temporaryBytesArray[iterator]].fertigationStage = OFF;
-                                    fieldValve[temporaryBytesArray[iterator]].fertigationValveInterrupted = false;
-                                    break;
+                                    count++;
                                 }
-                                count++;
-                            }
-                        }  
-                        myMsDelay(100);
-                        saveIrrigationValveValuesIntoEeprom(eepromAddress[temporaryBytesArray[iterator]], &fieldValve[temporaryBytesArray[iterator]]);
-                        myMsDelay(100);
-                        saveIrrigationValveDueTimeIntoEeprom(eepromAddress[temporaryBytesArray[iterator]], &fieldValve[temporaryBytesArray[iterator]]);
-                        myMsDelay(100);
-                        saveIrrigationValveOnOffStatusIntoEeprom(eepromAddress[temporaryBytesArray[iterator]], &fieldValve[temporaryBytesArray[iterator]]);
-                        myMsDelay(100);
-                        saveIrrigationValveCycleStatusIntoEeprom(eepromAddress[temporaryBytesArray[iterator]], &fieldValve[temporaryBytesArray[iterator]]);
-                        myMsDelay(100);
-                        saveIrrigationValveConfigurationStatusIntoEeprom(eepromAddress[temporaryBytesArray[iterator]], &fieldValve[temporaryBytesArray[iterator]]);
-                        myMsDelay(100);
-                        saveFertigationValveValuesIntoEeprom(eepromAddress[temporaryBytesArray[iterator]], &fieldValve[temporaryBytesArray[iterator]]);
-                        myMsDelay(100);
+                            }  
+                            valveCommitMask |= (unsigned int)1 << temporaryBytesArray[iterator];
+                        }
+                        blockCount++;
+                        // Move next block to start of decoded string
+                        if (blockLength < messageLength) {
+                            blockLength++; // skip separator
+                        }
+                        messageLength = messageLength - blockLength;
+                        memmove(decodedString, decodedString + blockLength, messageLength);
+                        decodedString[messageLength] = '\0';
+                        decodedStringBuffer.length = messageLength;
+                    } while (decodedStringBuffer.length > 3 && strncmp(decodedString, set, 3) == 0);
+                    commitConfiguredValves(); // Save all configured valves in one batch
+                    msgIndex = CLEAR;                   
+                    if (blockCount == 1) {
+                        /***************************/
+                        formatTwoDigits(fetchedPriority, temporaryBytesArray); // To store field no. of valve in action
+                        /***************************/
+                        sendSms(SmsIrr1, userMobileNo, fieldNoRequired); // Acknowledge user about successful Irrigation configuration
+                        /***************************/ 
                     }
-                    /***************************/
-                    // for field no. 01 to 09
-                    if (fetchedPriority < 10) {
-                        temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = fetchedPriority + 48; // To store field no. of valve in action 
-                    }// for field no. 10 to 12
-                    else if (fetchedPriority >=10 && fetchedPriority <= 12) {
-                        temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = fetchedPriority + 38; // To store field no. of valve in action 
+                    else {
+                        /***************************/
+                        formatTwoDigits(blockCount, temporaryBytesArray); // To store no. of priorities configured
+                        /***************************/
+                        sendSms(SmsIrr9, userMobileNo, noInfo); // Acknowledge user about successful bulk Irrigation configuration
+                        /***************************/ 
                     }
-                    /***************************/
-                    msgIndex = CLEAR;                   
-                    /***************************/
-                    sendSms(SmsIrr1, userMobileNo, fieldNoRequired); // Acknowledge user about successful Irrigation configuration
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
-                    /***************************/ 
                 #ifdef DEBUG_MODE_ON_H
                     //********Debug log#start************//
                     transmitStringToDebug("extractReceivedSms_Configure_SmsIrr1_OUT\r\n");
@@ -1026,26 +1435,11 @@ void extractReceivedSms(void) {
                     }
                     if (temp == 255) { // none of the valve have this priority
                         /***************************/
-                        // for field no. 01 to 09
-                        if (fetchedPriority < 10) {
-                            temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                            temporaryBytesArray[1] = fetchedPriority + 48; // To store field no. of valve in action 
-                        }// for field no. 10 to 12
-                        else if (fetchedPriority >=10 && fetchedPriority <= 12) {
-                            temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                            temporaryBytesArray[1] = fetchedPriority + 38; // To store field no. of valve in action 
-                        }
+                        formatTwoDigits(fetchedPriority, temporaryBytesArray); // To store field no. of valve in action
                         /***************************/
                         msgIndex = CLEAR;                   
                         /***************************/
                         sendSms(SmsIrr3, userMobileNo, fieldNoRequired); // Acknowledge user about successful Irrigation configuration disable action
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/ 
                     #ifdef DEBUG_MODE_ON_H
                         //********Debug log#start************//
@@ -1080,26 +1474,11 @@ void extractReceivedSms(void) {
                             }
                         }             
                         /***************************/
-                        // for field no. 01 to 09
-                        if (fetchedPriority < 10) {
-                            temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                            temporaryBytesArray[1] = fetchedPriority + 48; // To store field no. of valve in action 
-                        }// for field no. 10 to 12
-                        else if (fetchedPriority >=10 && fetchedPriority <= 12) {
-                            temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                            temporaryBytesArray[1] = fetchedPriority + 38; // To store field no. of valve in action 
-                        }
+                        formatTwoDigits(fetchedPriority, temporaryBytesArray); // To store field no. of valve in action
                         /***************************/
                         msgIndex = CLEAR;                   
                         /***************************/
                         sendSms(SmsIrr2, userMobileNo, fieldNoRequired); // Acknowledge user about successful Irrigation configuration disable action
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/ 
                     #ifdef DEBUG_MODE_ON_H
                         //********Debug log#start************//
@@ -1148,77 +1527,62 @@ void extractReceivedSms(void) {
                                         digit = CLEAR;
                                         break;
                                     case 4: // code to extract injector1OnPeriod;
-                                        fieldValve[iterator].injector1OnPeriod = digit;
+                                        program.onPeriod[0] = digit;
                                         digit = CLEAR;
                                         break;
                                     case 5: // code to extract injector1OffPeriod;
-                                        fieldValve[iterator].injector1OffPeriod = digit;
+                                        program.offPeriod[0] = digit;
                                         digit = CLEAR;
                                         break;
                                     case 6: // code to extract injector1Cycle;
-                                        fieldValve[iterator].injector1Cycle = (unsigned char)digit;
+                                        program.cycle[0] = (unsigned char)digit;
                                         digit = CLEAR;
                                         break;
                                     case 7: // code to extract injector2OnPeriod;
-                                        fieldValve[iterator].injector2OnPeriod = digit;
+                                        program.onPeriod[1] = digit;
                                         digit = CLEAR;
                                         break;
                                     case 8: // code to extract injector2OffPeriod;
-                                        fieldValve[iterator].injector2OffPeriod = digit;
+                                        program.offPeriod[1] = digit;
                                         digit = CLEAR;
                                         break;
                                     case 9: // code to extract injector2Cycle;
-                                        fieldValve[iterator].injector2Cycle = (unsigned char)digit;
+                                        program.cycle[1] = (unsigned char)digit;
                                         digit = CLEAR;
                                         break;
                                     case 10: // code to extract injector3OnPeriod;
-                                        fieldValve[iterator].injector3OnPeriod = digit;
+                                        program.onPeriod[2] = digit;
                                         digit = CLEAR;
                                         break;
                                     case 11: // code to extract injector3OffPeriod;
-                                        fieldValve[iterator].injector3OffPeriod = digit;
+                                        program.offPeriod[2] = digit;
                                         digit = CLEAR;
                                         break;
                                     case 12: // code to extract injector3Cycle;
-                                        fieldValve[iterator].injector3Cycle = (unsigned char)digit;
+                                        program.cycle[2] = (unsigned char)digit;
                                         digit = CLEAR;
                                         break;
                                     case 13: // code to extract injector4OnPeriod;
-                                        fieldValve[iterator].injector4OnPeriod = digit;
+                                        program.onPeriod[3] = digit;
                                         digit = CLEAR;
                                         break;
                                     case 14: // code to extract injector4OffPeriod;
-                                        fieldValve[iterator].injector4OffPeriod = digit;
+                                        program.offPeriod[3] = digit;
                                         digit = CLEAR;
                                         break;
                                     case 15: // code to extract injector1Cycle;
-                                        fieldValve[iterator].injector4Cycle = (unsigned char)digit;
+                                        program.cycle[3] = (unsigned char)digit;
                                         fieldValve[iterator].fertigationStage = OFF;
                                         fieldValve[iterator].fertigationValveInterrupted = false;
                                         digit = CLEAR;
-                                        if ((fieldValve[iterator].fertigationDelay + fieldValve[iterator].fertigationONperiod) >= fieldValve[iterator].onPeriod) {
+                                        if ((fieldValve[iterator].fertigationDelay + fieldValve[iterator].fertigationONperiod) >= fieldValve[iterator].onPeriod || !assignInjectorProgram(&fieldValve[iterator], &program)) {
                                             fieldValve[iterator].isFertigationEnabled = false;
                                             /***************************/
-                                            // for field no. 01 to 09
-                                            if (fetchedPriority < 10) {
-                                                temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                                                temporaryBytesArray[1] = fetchedPriority + 48; // To store field no. of valve in action 
-                                            }// for field no. 10 to 12
-                                            else if (fetchedPriority >=10 && fetchedPriority <= 12) {
-                                                temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                                                temporaryBytesArray[1] = fetchedPriority + 38; // To store field no. of valve in action 
-                                            }
+                                            formatTwoDigits(fetchedPriority, temporaryBytesArray); // To store field no. of valve in action
                                             /***************************/
                                             msgIndex = CLEAR;
                                             /***************************/
                                             sendSms(SmsFert2, userMobileNo, fieldNoRequired);   // Acknowledge user about Fertigation not configured due to incorrect values
-                                        #ifdef SMS_DELIVERY_REPORT_ON_H
-                                            sleepCount = 2; // Load sleep count for SMS transmission action
-                                            sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                                            setBCDdigit(0x05,0);
-                                            deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                                            setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                                        #endif
                                             /***************************/
                                         #ifdef DEBUG_MODE_ON_H
                                             //********Debug log#start************//
@@ -1241,18 +1605,7 @@ void extractReceivedSms(void) {
                                                         fieldValve[iterator].fertigationDelay = fieldValve[temp].fertigationDelay;
                                                         fieldValve[iterator].fertigationONperiod = fieldValve[temp].fertigationONperiod;
                                                         fieldValve[iterator].fertigationInstance = fieldValve[temp].fertigationInstance;
-                                                        fieldValve[iterator].injector1OnPeriod = fieldValve[temp].injector1OnPeriod;
-                                                        fieldValve[iterator].injector1OffPeriod = fieldValve[temp].injector1OffPeriod;
-                                                        fieldValve[iterator].injector1Cycle = fieldValve[temp].injector1Cycle;
-                                                        fieldValve[iterator].injector2OnPeriod = fieldValve[temp].injector2OnPeriod;
-                                                        fieldValve[iterator].injector2OffPeriod = fieldValve[temp].injector2OffPeriod;
-                                                        fieldValve[iterator].injector2Cycle = fieldValve[temp].injector2Cycle;
-                                                        fieldValve[iterator].injector3OnPeriod = fieldValve[temp].injector3OnPeriod;
-                                                        fieldValve[iterator].injector3OffPeriod = fieldValve[temp].injector3OffPeriod;
-                                                        fieldValve[iterator].injector3Cycle = fieldValve[temp].injector3Cycle;
-                                                        fieldValve[iterator].injector4OnPeriod = fieldValve[temp].injector4OnPeriod;
-                                                        fieldValve[iterator].injector4OffPeriod = fieldValve[temp].injector4OffPeriod;
-                                                        fieldValve[iterator].injector4Cycle = fieldValve[temp].injector4Cycle;
+                                                        fieldValve[iterator].injectorSlot = fieldValve[temp].injectorSlot;
                                                         fieldValve[iterator].fertigationStage = fieldValve[temp].fertigationStage;
                                                         fieldValve[iterator].fertigationValveInterrupted = fieldValve[temp].fertigationValveInterrupted;
                                                         myMsDelay(100);
@@ -1263,26 +1616,11 @@ void extractReceivedSms(void) {
                                             }
                                             //iterator = temp;
                                             /***************************/
-                                            // for field no. 01 to 09
-                                            if (fetchedPriority < 10) {
-                                                temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                                                temporaryBytesArray[1] = fetchedPriority + 48; // To store field no. of valve in action 
-                                            }// for field no. 10 to 12
-                                            else if (fetchedPriority >=10 && fetchedPriority <= 12) {
-                                                temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                                                temporaryBytesArray[1] = fetchedPriority + 38; // To store field no. of valve in action 
-                                            }
+                                            formatTwoDigits(fetchedPriority, temporaryBytesArray); // To store field no. of valve in action
                                             /***************************/
                                             msgIndex = CLEAR;
                                             /***************************/                       
                                             sendSms(SmsFert3, userMobileNo, fieldNoRequired);  // Acknowledge user about successful Fertigation enabled action
-                                        #ifdef SMS_DELIVERY_REPORT_ON_H
-                                            sleepCount = 2; // Load sleep count for SMS transmission action
-                                            sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                                            setBCDdigit(0x05,0);
-                                            deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                                            setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                                        #endif
                                             /***************************/
                                             /***************************/
                                         #ifdef DEBUG_MODE_ON_H
@@ -1299,26 +1637,11 @@ void extractReceivedSms(void) {
                         }
                     }
                     /***************************/
-                    // for field no. 01 to 09
-                    if (fetchedPriority < 10) {
-                        temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = fetchedPriority + 48; // To store field no. of valve in action 
-                    }// for field no. 10 to 12
-                    else if (fetchedPriority >=10 && fetchedPriority <= 12) {
-                        temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = fetchedPriority + 38; // To store field no. of valve in action 
-                    }
+                    formatTwoDigits(fetchedPriority, temporaryBytesArray); // To store field no. of valve in action
                     /***************************/
                     msgIndex = CLEAR;
                     /***************************/                       
                     sendSms(SmsFert1, userMobileNo, fieldNoRequired);  // Acknowledge user about successful Fertigation enabled action
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/
                     /***************************/
                 #ifdef DEBUG_MODE_ON_H
@@ -1346,26 +1669,11 @@ void extractReceivedSms(void) {
                     }
                     if (temp == 255) { // none of the valve matching fetched priority
                         /***************************/
-                        // for field no. 01 to 09
-                        if (fetchedPriority < 10) {
-                            temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                            temporaryBytesArray[1] = fetchedPriority + 48; // To store field no. of valve in action 
-                        }// for field no. 10 to 12
-                        else if (fetchedPriority >=10 && fetchedPriority <= 12) {
-                            temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                            temporaryBytesArray[1] = fetchedPriority + 38; // To store field no. of valve in action 
-                        }
+                        formatTwoDigits(fetchedPriority, temporaryBytesArray); // To store field no. of valve in action
                         /***************************/
                         msgIndex = CLEAR;
                         /***************************/                       
                         sendSms(SmsIrr3, userMobileNo, fieldNoRequired);  // Acknowledge user about successful Fertigation enabled action
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/
                         /***************************/
                     #ifdef DEBUG_MODE_ON_H
@@ -1385,26 +1693,11 @@ void extractReceivedSms(void) {
                             }
                         }
                         /***************************/
-                        // for field no. 01 to 09
-                        if (fetchedPriority < 10) {
-                            temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                            temporaryBytesArray[1] = fetchedPriority + 48; // To store field no. of valve in action 
-                        }// for field no. 10 to 12
-                        else if (fetchedPriority >=10 && fetchedPriority <= 12) {
-                            temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                            temporaryBytesArray[1] = fetchedPriority + 38; // To store field no. of valve in action 
-                        }
+                        formatTwoDigits(fetchedPriority, temporaryBytesArray); // To store field no. of valve in action
                         /***************************/
                         msgIndex = CLEAR;
                         /***************************/
                         sendSms(SmsFert4, userMobileNo, fieldNoRequired);   // Acknowledge user about successful Fertigation disabled action
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/ 
                     #ifdef DEBUG_MODE_ON_H
                         //********Debug log#start************//
@@ -1466,13 +1759,6 @@ void extractReceivedSms(void) {
                     msgIndex = CLEAR;
                     /***************************/
                     sendSms(SmsFilt1, userMobileNo, noInfo);
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/ 
                 #ifdef DEBUG_MODE_ON_H
                     //********Debug log#start************//
@@ -1491,13 +1777,6 @@ void extractReceivedSms(void) {
                     msgIndex = CLEAR;
                     /***************************/
                     sendSms(SmsFilt2, userMobileNo, noInfo);
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/ 
                 #ifdef DEBUG_MODE_ON_H
                     //********Debug log#start************//
@@ -1513,26 +1792,12 @@ void extractReceivedSms(void) {
                         msgIndex = CLEAR;
                         /***************************/
                         sendSms(SmsFilt4, userMobileNo, filtrationData);
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/
                     }
                     else {
                         msgIndex = CLEAR;
                         /***************************/
                         sendSms(SmsFilt3, userMobileNo, noInfo);
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/                    
                     }
                     /***************************/
@@ -1590,13 +1855,6 @@ void extractReceivedSms(void) {
                             msgIndex = CLEAR;
                             /***************************/
                             sendSms(SmsT1, userMobileNo, noInfo);
-                        #ifdef SMS_DELIVERY_REPORT_ON_H
-                            sleepCount = 2; // Load sleep count for SMS transmission action
-                            sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                            setBCDdigit(0x05,0);
-                            deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                            setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                        #endif
                             /***************************/ 
                         #ifdef DEBUG_MODE_ON_H
                             //********Debug log#start************//
@@ -1612,13 +1870,6 @@ void extractReceivedSms(void) {
                     msgIndex = CLEAR;           
                     /***************************/
                     sendSms(SmsRTC2, userMobileNo, noInfo);
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/ 
                 #ifdef DEBUG_MODE_ON_H
                     //********Debug log#start************//
@@ -1630,34 +1881,21 @@ void extractReceivedSms(void) {
                 //#12>..............Get RTC Time.................//
                 // Get current Time
                 else if (strncmp(decodedString, time, 4) == 0) {
-                    fetchTimefromRTC(); // Get today's date
-                    temporaryBytesArray[0] = (currentDD / 10) + 48;
-                    temporaryBytesArray[1] = (currentDD % 10) + 48;
+                    getCurrentTime(); // Get today's date
+                    formatTwoDigits(currentDD, temporaryBytesArray);
                     temporaryBytesArray[2] = '/';
-                    temporaryBytesArray[3] = (currentMM / 10) + 48;
-                    temporaryBytesArray[4] = (currentMM % 10) + 48;
+                    formatTwoDigits(currentMM, temporaryBytesArray+3);
                     temporaryBytesArray[5] = '/';
-                    temporaryBytesArray[6] = (currentYY / 10) + 48;
-                    temporaryBytesArray[7] = (currentYY % 10) + 48;
+                    formatTwoDigits(currentYY, temporaryBytesArray+6);
                     temporaryBytesArray[8] = ' ';
-                    temporaryBytesArray[9] = (currentHour / 10) + 48;
-                    temporaryBytesArray[10] = (currentHour % 10) + 48;
+                    formatTwoDigits(currentHour, temporaryBytesArray+9);
                     temporaryBytesArray[11] = ':';
-                    temporaryBytesArray[12] = (currentMinutes / 10) + 48;
-                    temporaryBytesArray[13] = (currentMinutes % 10) + 48;
+                    formatTwoDigits(currentMinutes, temporaryBytesArray+12);
                     temporaryBytesArray[14] = ':';
-                    temporaryBytesArray[15] = (currentSeconds / 10) + 48;
-                    temporaryBytesArray[16] = (currentSeconds % 10) + 48;
+                    formatTwoDigits(currentSeconds, temporaryBytesArray+15);
                     msgIndex = CLEAR;
                     /***************************/
                     sendSms(SmsT2, userMobileNo, timeRequired);
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/
                 #ifdef DEBUG_MODE_ON_H
                     //********Debug log#start************//
@@ -1671,39 +1909,17 @@ void extractReceivedSms(void) {
                 else if (strncmp(decodedString, extract, 7) == 0) {
                     iterator = fetchFieldNo(7);
                     /***************************/
-                    // for field no. 01 to 09
-                    if (iterator<9){
-                        temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = iterator + 49; // To store field no. of valve in action 
-                    }// for field no. 10 to 12
-                    else if (iterator > 8 && iterator < 12) {
-                        temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = iterator + 39; // To store field no. of valve in action 
-                    }
+                    formatFieldNo(iterator, temporaryBytesArray); // To store field no. of valve in action
                     /***************************/
                     msgIndex = CLEAR;
                     if (fieldValve[iterator].isConfigured) {
                         /***************************/ 
                         sendSms(SmsIrr7, userMobileNo, IrrigationData);  // Give diagnostic data
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/
                     }
                     else {
                         /***************************/                        
                         sendSms(SmsIrr3, userMobileNo, fieldNoRequired);  // Acknowledge user about  Irrigation not configured
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/
                     }
                 #ifdef DEBUG_MODE_ON_H
@@ -1720,13 +1936,6 @@ void extractReceivedSms(void) {
                         msgIndex = CLEAR;
                         /***************************/
                         sendSms(SmsMotor4, userMobileNo, noInfo);   // Acknowledge user about Irrigation is active, Motor load cut-off procedure not started
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/
                     #ifdef DEBUG_MODE_ON_H
                         //********Debug log#start************//
@@ -1771,13 +1980,6 @@ void extractReceivedSms(void) {
                     msgIndex = CLEAR;
                     /***************************/
                     sendSms(SmsMotor2, userMobileNo, noInfo);
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/
                 #ifdef DEBUG_MODE_ON_H
                     //********Debug log#start************//
@@ -1791,13 +1993,6 @@ void extractReceivedSms(void) {
                     msgIndex = CLEAR;
                     /***************************/
                     sendSms(SmsMotor3, userMobileNo, motorLoadRequired);
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission	
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/
                 #ifdef DEBUG_MODE_ON_H
                     //********Debug log#start************//
@@ -1810,29 +2005,15 @@ void extractReceivedSms(void) {
                 else if (strncmp(decodedString, getfreq, 7) == 0) {
                     iterator = fetchFieldNo(7);
                     myMsDelay(100);
-                    isFieldMoistureSensorWet(iterator);
+                    measureFieldMoisture(iterator); // Measure current moisture level of given field
+                    moistureLevel = getMoistureLevel(moisturePeriod); // Frequency is required only for report
                     /***************************/
-                    // for field no. 01 to 09
-                    if (iterator<9){
-                        temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = iterator + 49; // To store field no. of valve in action 
-                    }// for field no. 10 to 12
-                    else if (iterator > 8 && iterator < 12) {
-                        temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = iterator + 39; // To store field no. of valve in action 
-                    }
+                    formatFieldNo(iterator, temporaryBytesArray); // To store field no. of valve in action
                     /***************************/
                     if(moistureSensorFailed) {
                         moistureSensorFailed = false;
                         /***************************/
                         sendSms(SmsMS3, userMobileNo, fieldNoRequired);
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/
                     }
                     else {
@@ -1840,13 +2021,6 @@ void extractReceivedSms(void) {
                         msgIndex = CLEAR;
                         /***************************/                        
                         sendSms(SmsMS2, userMobileNo, frequencyRequired);
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/
 
                     }
@@ -1867,13 +2041,6 @@ void extractReceivedSms(void) {
                         msgIndex = CLEAR;
                         /***************************/
                         sendSms(SmsMotor4, userMobileNo, noInfo);  // Acknowledge user about Irrigation is active, Motor load cut-off procedure not started
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/
                     #ifdef DEBUG_MODE_ON_H
                         //********Debug log#start************//
@@ -1883,15 +2050,7 @@ void extractReceivedSms(void) {
                         return;
                     }
                     /***************************/
-                    // for field no. 01 to 09
-                    if (iterator<9){
-                        temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = iterator + 49; // To store field no. of valve in action 
-                    }// for field no. 10 to 12
-                    else if (iterator > 8 && iterator < 12) {
-                        temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = iterator + 39; // To store field no. of valve in action 
-                    }
+                    formatFieldNo(iterator, temporaryBytesArray); // To store field no. of valve in action
                     myMsDelay(5000);
                     //calibrateMotorCurrent(NoLoad, iterator);
                     //myMsDelay(1000);
@@ -1902,13 +2061,6 @@ void extractReceivedSms(void) {
                     msgIndex = CLEAR;
                     /***************************/
                     sendSms(SmsMotor3, userMobileNo, motorLoadRequired);
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/
                 #ifdef DEBUG_MODE_ON_H
                     //********Debug log#start************//
@@ -1917,6 +2069,131 @@ void extractReceivedSms(void) {
                 #endif
                     return;
                 }
+                //#18>......Get status of all configured valves in one SMS.......//
+                // STATUS
+                else if (strncmp(decodedString, status, 6) == 0) {
+                    msgIndex = CLEAR;
+                    /***************************/
+                    sendSms(SmsIrr8, userMobileNo, noInfo);  // Give status of all configured valves
+                    /***************************/
+                #ifdef DEBUG_MODE_ON_H
+                    //********Debug log#start************//
+                    transmitStringToDebug("extractReceivedSms_sendValveStatus_OUT\r\n");
+                    //********Debug log#end**************//
+                #endif
+                    return;
+                }
+                //#19>......Export configuration snapshot.......//
+                // BACKUP
+                else if (strncmp(decodedString, backup, 6) == 0) {
+                    msgIndex = CLEAR;
+                    if (buildConfigurationSnapshot()) {
+                        /***************************/
+                        sendSms(SmsCfg1, userMobileNo, noInfo);  // Give configuration snapshot as RESTORE parts
+                        /***************************/
+                    }
+                    else {
+                        /***************************/
+                        sendSms(SmsCfg4, userMobileNo, noInfo);  // Acknowledge user about configuration snapshot not built
+                        /***************************/
+                    }
+                #ifdef DEBUG_MODE_ON_H
+                    //********Debug log#start************//
+                    transmitStringToDebug("extractReceivedSms_BackupConfiguration_OUT\r\n");
+                    //********Debug log#end**************//
+                #endif
+                    return;
+                }
+                //#20>......Restore configuration snapshot.......//
+                // RESTORE<PartNo><Space><base64 part>
+                else if (strncmp(decodedString, restore, 7) == 0) {
+                    // Valve status and priorities are not overwritten while valve or motor is running
+                    if (valveDue || MotorControl == ON) {
+                        snapshotLength = CLEAR;
+                        snapshotPart = CLEAR;
+                        msgIndex = CLEAR;
+                        /***************************/
+                        sendSms(SmsCfg5, userMobileNo, noInfo);  // Acknowledge user about Irrigation is active, RESTORE not accepted
+                        /***************************/
+                    #ifdef DEBUG_MODE_ON_H
+                        //********Debug log#start************//
+                        transmitStringToDebug("extractReceivedSms_RestoreConfiguration_SmsCfg5_OUT\r\n");
+                        //********Debug log#end**************//
+                    #endif
+                        return;
+                    }
+                    count = fetchFieldNo(7) + 1; // fetch part no. and add 1 for 1-12 range
+                    // First part starts new snapshot, other parts are accepted only in order
+                    if (count == 1) {
+                        snapshotLength = CLEAR;
+                        snapshotPart = CLEAR;
+                    }
+                    if (count == 0 || count != snapshotPart + 1 || decodedString[9] != space || !decodeSnapshotPart(10)) {
+                        snapshotLength = CLEAR;
+                        snapshotPart = CLEAR;
+                        msgIndex = CLEAR;
+                        /***************************/
+                        sendSms(SmsCfg3, userMobileNo, noInfo);  // Acknowledge user about invalid RESTORE part
+                        /***************************/
+                    #ifdef DEBUG_MODE_ON_H
+                        //********Debug log#start************//
+                        transmitStringToDebug("extractReceivedSms_RestoreConfiguration_SmsCfg3_OUT\r\n");
+                        //********Debug log#end**************//
+                    #endif
+                        return;
+                    }
+                    snapshotPart = count;
+                    // Apply snapshot once length given in header is received
+                    if (snapshotLength >= snapshotHeaderSize && snapshotLength >= (((unsigned int)snapshotImage[1] << 8) | snapshotImage[2])) {
+                        msgIndex = CLEAR;
+                        if (snapshotLength == (((unsigned int)snapshotImage[1] << 8) | snapshotImage[2]) && applyConfigurationSnapshot()) {
+                            /***************************/
+                            sendSms(SmsCfg2, userMobileNo, noInfo);  // Acknowledge user about successful configuration restore
+                            /***************************/
+                        }
+                        else {
+                            /***************************/
+                            sendSms(SmsCfg3, userMobileNo, noInfo);  // Acknowledge user about corrupted configuration snapshot
+                            /***************************/
+                        }
+                        snapshotLength = CLEAR;
+                        snapshotPart = CLEAR;
+                    }
+                #ifdef DEBUG_MODE_ON_H
+                    //********Debug log#start************//
+                    transmitStringToDebug("extractReceivedSms_RestoreConfiguration_OUT\r\n");
+                    //********Debug log#end**************//
+                #endif
+                    return;
+                }
+                //#21>......Preview valve actions of next days.......//
+                // PLAN<Space><Days>
+                else if (strncmp(decodedString, plan, 4) == 0) {
+                    digit = CLEAR;
+                    for (msgIndex = 5; msgIndex < 7 && msgIndex < decodedStringBuffer.length && isNumber(decodedString[msgIndex]); msgIndex++) {
+                        digit = (digit * 10) + (decodedString[msgIndex] - 48);
+                    }
+                    if (digit == 0) {
+                        digit = 1; // Plan for today by default
+                    }
+                    else if (digit > planMaxDays) {
+                        digit = planMaxDays;
+                    }
+                    planValveSchedule((unsigned char)digit);
+                    /***************************/
+                    formatTwoDigits((unsigned char)digit, temporaryBytesArray); // To store no. of days in plan
+                    /***************************/
+                    msgIndex = CLEAR;
+                    /***************************/
+                    sendSms(SmsPlan1, userMobileNo, noInfo);  // Give valve actions of next days
+                    /***************************/
+                #ifdef DEBUG_MODE_ON_H
+                    //********Debug log#start************//
+                    transmitStringToDebug("extractReceivedSms_PlanValveSchedule_OUT\r\n");
+                    //********Debug log#end**************//
+                #endif
+                    return;
+                }
                 //#xx>......InjectTestData.......//
                 // INJECT<Space><HR><Space><MIN><Space><trigger>
                 else if (strncmp(decodedString, inject, 6) == 0) {
@@ -1957,6 +2234,7 @@ void extractReceivedSms(void) {
                         fieldValve[iterator].nextDueYY = dueYY;
                         fieldValve[iterator].dryValue = 100;
                         fieldValve[iterator].wetValue = 30000;
+                        fieldValve[iterator].wetValuePeriod = getMoisturePeriod(30000);
                         fieldValve[iterator].priority = iterator+1;
                         fieldValve[iterator].status = OFF;
                         fieldValve[iterator].cycles = 2;
@@ -1968,6 +2246,7 @@ void extractReceivedSms(void) {
                         fieldValve[iterator].fertigationStage = OFF;
                         fieldValve[iterator].fertigationValveInterrupted = false;
                         fieldValve[iterator].isFertigationEnabled = true;
+                        fieldValve[iterator].injectorSlot = noInjectorProgram; // Injectors are not used in test data
 
                         saveIrrigationValveValuesIntoEeprom(eepromAddress[iterator], &fieldValve[iterator]);
                         myMsDelay(100);
@@ -1985,13 +2264,6 @@ void extractReceivedSms(void) {
                     msgIndex = CLEAR;
                     /***************************/
                     sendSms(SmsTest, userMobileNo, noInfo);
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/
                 #ifdef DEBUG_MODE_ON_H
                     //********Debug log#start************//
@@ -2010,13 +2282,6 @@ void extractReceivedSms(void) {
                         msgIndex = CLEAR;
                         /***************************/
                         sendSms(SmsAU2, userMobileNo, newAdmin); //To notify old Admin about new Admin.
-                    #ifdef SMS_DELIVERY_REPORT_ON_H
-                        sleepCount = 2; // Load sleep count for SMS transmission action
-                        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                        setBCDdigit(0x05,0);
-                        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                    #endif
                         /***************************/
                     }
                     strncpy(pwd, decodedString + 10, 6);
@@ -2033,13 +2298,6 @@ void extractReceivedSms(void) {
                     msgIndex = CLEAR;
                     /***************************/
                     sendSms(SmsAU1, userMobileNo, noInfo);  // Acknowledge user about successful Admin Registration
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/
                 #ifdef DEBUG_MODE_ON_H
                     //********Debug log#start************//
@@ -2052,13 +2310,6 @@ void extractReceivedSms(void) {
                     msgIndex = CLEAR;
                     /***************************/
                     sendSms(SmsPwd3, temporaryBytesArray, noInfo);
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/
                 #ifdef DEBUG_MODE_ON_H
                     //********Debug log#start************//
@@ -2074,13 +2325,6 @@ void extractReceivedSms(void) {
                 msgIndex = CLEAR;
                 /***************************/
                 sendSms(SmsAU3, temporaryBytesArray, noInfo);   // Acknowledge user about Authentication failed
-            #ifdef SMS_DELIVERY_REPORT_ON_H
-                sleepCount = 2; // Load sleep count for SMS transmission action
-                sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission	
-                setBCDdigit(0x05,0);
-                deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-            #endif
                 /***************************/
             #ifdef DEBUG_MODE_ON_H
                 //********Debug log#start************//
@@ -2095,13 +2339,6 @@ void extractReceivedSms(void) {
                 msgIndex = CLEAR;
                 /***************************/
                 sendSms(SmsKey1, temporaryBytesArray, secretCodeRequired);
-            #ifdef SMS_DELIVERY_REPORT_ON_H
-                sleepCount = 2; // Load sleep count for SMS transmission action
-                sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission	
-                setBCDdigit(0x05,0);
-                deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-            #endif
                 /***************************/
             #ifdef DEBUG_MODE_ON_H
                 //********Debug log#start************//
@@ -2116,13 +2353,6 @@ void extractReceivedSms(void) {
                 msgIndex = CLEAR;
                 /***************************/
                 sendSms(SmsKey2, temporaryBytesArray, secretCode1Required);
-            #ifdef SMS_DELIVERY_REPORT_ON_H
-                sleepCount = 2; // Load sleep count for SMS transmission action
-                sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission	
-                setBCDdigit(0x05,0);
-                deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-            #endif
                 /***************************/
             #ifdef DEBUG_MODE_ON_H
                 //********Debug log#start************//
@@ -2177,7 +2407,45 @@ void extractReceivedSms(void) {
 
 /*************************************************************************************************************************
 
-This function is called to measure soil moisture of given field and indicate if wet field found .
+This function is called to read output level of moisture sensor connected to given field.
+The purpose of this function is to select one of the 12 moisture sensor input lines as per field no.
+
+ **************************************************************************************************************************/
+_Bool isMoistureSensorHigh(unsigned char FieldNo) {
+    // check field no. of sensor to be read
+    switch (FieldNo) {
+    case 0:
+        return MoistureSensor1;
+    case 1:
+        return MoistureSensor2;
+    case 2:
+        return MoistureSensor3;
+    case 3:
+        return MoistureSensor4;
+    case 4:
+        return MoistureSensor5;
+    case 5:
+        return MoistureSensor6;
+    case 6:
+        return MoistureSensor7;
+    case 7:
+        return MoistureSensor8;
+    case 8:
+        return MoistureSensor9;
+    case 9:
+        return MoistureSensor10;
+    case 10:
+        return MoistureSensor11;
+    case 11:
+        return MoistureSensor12;
+    default:
+        return LOW;
+    }
+}
+
+/*************************************************************************************************************************
+
+This function is called to measure soil moisture of given field and store it in field moisture table.
 The Moisture level is measured in terms of frequency of square wave generated by IC555 based on Senor resistance.
 The Sensor resistance is high and low for Dry and Wet condition respectively.
 This leads the output of IC555 with high and low pulse width.
@@ -2186,37 +2454,22 @@ i.e. for Dry condition pulse occurrence is low and for wet condition pulse occur
 Here Timer1 is used to count frequency of pulses by measuring timer count for 1 pulse width and averaging it for 10 pulses.
 
  **************************************************************************************************************************/
-_Bool isFieldMoistureSensorWet(unsigned char FieldNo) {
-    unsigned long moistureLevelAvg = CLEAR;
+void measureFieldMoisture(unsigned char FieldNo) {
+    unsigned long cycleWidth = CLEAR; // To store cycle width of one pulse in Timer1 counts
     unsigned long timer1Value = CLEAR; // To store 16 bit SFR Timer1 Register value
-    unsigned long constant = 160000; // Constant to calculate frequency in Hz ~16MHz 16000000/100 to convert freq from 5 digit to 3 digit
     unsigned char itr = CLEAR, avg = 20; 
-    moistureLevel = CLEAR; // To store moisture level in Hz   
+    moisturePeriod = CLEAR; // To store averaged cycle width
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
     /***************************/
-    // for field no. 01 to 09
-    if (FieldNo<9){
-        temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-        temporaryBytesArray[1] = FieldNo + 49; // To store field no. of valve in action 
-    }// for field no. 10 to 12
-    else if (FieldNo > 8 && FieldNo < 12) {
-        temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-        temporaryBytesArray[1] = FieldNo + 39; // To store field no. of valve in action 
-    }
-    else {
-        temporaryBytesArray[0] = 57; // To store field no. of valve in action 
-        temporaryBytesArray[1] = 57; // To store field no. of valve in action 
-    
-    }
+    formatFieldNo(FieldNo, temporaryBytesArray); // To store field no. of valve in action
     /***************************/
-    transmitStringToDebug("isFieldMoistureSensorWet_IN : ");
+    transmitStringToDebug("measureFieldMoisture_IN : ");
     transmitNumberToDebug(temporaryBytesArray, 2);
     transmitStringToDebug("\r\n");
     //********Debug log#end**************//
 #endif  
     setBCDdigit(0x09,0); // (9.) BCD indication for Moisture Sensor Failure Error
-    moistureLevel = LOW;
     checkMoistureSensor = true;
     moistureSensorFailed = false;
     timer3Count = 5; // 5 second window
@@ -2229,21 +2482,21 @@ _Bool isFieldMoistureSensorWet(unsigned char FieldNo) {
         // check field moisture of valve in action
     #ifdef DEBUG_MODE_ON_H
         //********Debug log#start************//
-        transmitStringToDebug("MoistureSensor1 == HIGH\r\n");
+        transmitStringToDebug("MoistureSensor == HIGH\r\n");
         //********Debug log#end**************//
     #endif
         T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if Sensor fails to respond within 15 sec   
         controllerCommandExecuted = false;
-        /*******Sensor 1) is selected as common sensor for all fields*******/
-        while (MoistureSensor1 == HIGH && controllerCommandExecuted == false);
+        /*******Sensor of given field is selected*******/
+        while (isMoistureSensorHigh(FieldNo) == HIGH && controllerCommandExecuted == false);
     #ifdef DEBUG_MODE_ON_H
         //********Debug log#start************//
-        transmitStringToDebug("MoistureSensor1 == LOW\r\n");
+        transmitStringToDebug("MoistureSensor == LOW\r\n");
         //********Debug log#end**************//
     #endif
-        while (MoistureSensor1 == LOW && controllerCommandExecuted == false); // Wait for rising edge
+        while (isMoistureSensorHigh(FieldNo) == LOW && controllerCommandExecuted == false); // Wait for rising edge
         T1CONbits.TMR1ON = ON; // Start Timer after rising edge detected
-        while (MoistureSensor1 == HIGH && controllerCommandExecuted == false); // Wait for falling edge
+        while (isMoistureSensorHigh(FieldNo) == HIGH && controllerCommandExecuted == false); // Wait for falling edge
         if (!controllerCommandExecuted) {
             controllerCommandExecuted = true;
             PIR5bits.TMR3IF = SET; //Stop timer thread 
@@ -2251,21 +2504,169 @@ _Bool isFieldMoistureSensorWet(unsigned char FieldNo) {
         T1CONbits.TMR1ON = OFF; // Stop timer after falling edge detected
         timer1Value = TMR1L;    // Store lower byte of 16 bit timer
         timer1Value|=((unsigned int)TMR1H) << 8;    // Get higher and lower byte of  timer1 register
-        moistureLevelAvg = (Timer1Overflow * 65536) + timer1Value;
-        moistureLevelAvg *= 2; // Entire cycle width
-        moistureLevelAvg = (constant / moistureLevelAvg); // Frequency = 16Mhz/ Pulse Width
+        cycleWidth = ((unsigned long)Timer1Overflow << 16) + timer1Value;
+        cycleWidth <<= 1; // Entire cycle width
+        // Period is averaged, frequency is computed only for report
+        if (cycleWidth > moisturePeriodMax) {
+            cycleWidth = moisturePeriodMax;
+        }
         if (itr == 1) {
-            moistureLevel = (unsigned int)moistureLevelAvg;
+            moisturePeriod = (unsigned int)cycleWidth;
         }
-        moistureLevel = moistureLevel/2;
-        moistureLevelAvg = moistureLevelAvg/2;
-        moistureLevel = moistureLevel + (unsigned int)moistureLevelAvg;
+        moisturePeriod = (moisturePeriod >> 1) + ((unsigned int)cycleWidth >> 1);
         if(moistureSensorFailed) {
-            moistureLevel = 0;
+            moisturePeriod = moisturePeriodMax;
         }
     }
     checkMoistureSensor = false;
     setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
+    saveFieldMoisture(FieldNo);
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("measureFieldMoisture_OUT\r\n");
+    //********Debug log#end**************//
+#endif
+}
+
+/*************************************************************************************************************************
+
+This function is called to store measured moisture level of given field in field moisture table.
+The purpose of this function is to keep cycle width and sensor status with date and time of measurement,
+so that reading older than moistureReadingMaxAge is not used.
+
+ **************************************************************************************************************************/
+void saveFieldMoisture(unsigned char FieldNo) {
+    unsigned int fieldBit;
+    if (FieldNo >= 12) {
+        return;
+    }
+    fieldBit = (unsigned int)1 << FieldNo;
+    fieldMoisturePeriod[FieldNo] = moisturePeriod;
+    fieldMoistureMeasured |= fieldBit;
+    if (moistureSensorFailed) {
+        fieldMoistureFailed |= fieldBit;
+    }
+    else {
+        fieldMoistureFailed &= ~fieldBit;
+    }
+    getCurrentTime();
+    fieldMoistureDay[FieldNo] = getPlanDayNumber(currentDD, currentMM, currentYY);
+    fieldMoistureMinute[FieldNo] = (unsigned int)currentHour * 60 + currentMinutes;
+}
+
+/*************************************************************************************************************************
+
+This function is called to check if moisture sensor of given field is generating pulses.
+The purpose of this function is to detect failed sensor within few milliseconds instead of 5 second measurement window.
+Sensor output of measurable range changes level within moistureProbeOverflows overflows of Timer1.
+
+ **************************************************************************************************************************/
+_Bool isMoistureSensorActive(unsigned char FieldNo) {
+    _Bool level = isMoistureSensorHigh(FieldNo);
+    T1CONbits.TMR1ON = OFF;
+    TMR1H = CLEAR;
+    TMR1L = CLEAR;
+    Timer1Overflow = CLEAR;
+    T1CONbits.TMR1ON = ON;
+    while (Timer1Overflow < moistureProbeOverflows) {
+        if (isMoistureSensorHigh(FieldNo) != level) {
+            T1CONbits.TMR1ON = OFF;
+            return true;
+        }
+    }
+    T1CONbits.TMR1ON = OFF;
+    return false;
+}
+
+/*************************************************************************************************************************
+
+This function is called to convert moisture frequency value into sensor cycle width.
+The purpose of this function is to convert wet value of field once, so that measured cycle width is compared without division.
+Frequency at or above given value is cycle width at or below returned value.
+
+ **************************************************************************************************************************/
+unsigned int getMoisturePeriod(unsigned int frequency) {
+    if (frequency == CLEAR) {
+        return moisturePeriodMax; // Any measurement is at or above zero frequency
+    }
+    if (frequency < 3) {
+        return moisturePeriodMax - 1; // Cycle width beyond 16 bit range, failed sensor is excluded
+    }
+    return (unsigned int)(moistureFrequencyConstant / frequency);
+}
+
+/*************************************************************************************************************************
+
+This function is called to convert sensor cycle width into moisture frequency value.
+The purpose of this function is to report moisture level in same units as user configured dry and wet values.
+
+ **************************************************************************************************************************/
+unsigned int getMoistureLevel(unsigned int period) {
+    if (period < 3) {
+        return 0xFFFF; // Frequency beyond 16 bit range
+    }
+    return (unsigned int)(moistureFrequencyConstant / period);
+}
+
+/*************************************************************************************************************************
+
+This function is called to measure moisture sensor of next configured field in round robin manner.
+The purpose of this function is to keep field moisture table updated in background during sleep wake ups,
+so that due valves can be checked against their own field sensor without measuring all fields at once.
+Only one field sensor is measured per call, sensor not changing level is stored as failed without waiting for measurement window.
+
+ **************************************************************************************************************************/
+void scanNextFieldMoistureSensor(void) {
+    unsigned char itr = CLEAR;
+    // Navigate through fields starting from next scan field no. till configured field found
+    for (itr = 0; itr < fieldCount; itr++) {
+        if (moistureScanFieldNo >= fieldCount) {
+            moistureScanFieldNo = 0;
+        }
+        if (fieldValve[moistureScanFieldNo].isConfigured) {
+            if (isMoistureSensorActive(moistureScanFieldNo)) {
+                measureFieldMoisture(moistureScanFieldNo);
+            }
+            else {
+                moisturePeriod = moisturePeriodMax;
+                moistureSensorFailed = true;
+                saveFieldMoisture(moistureScanFieldNo);
+            }
+            moistureScanFieldNo++;
+            break;
+        }
+        moistureScanFieldNo++;
+    }
+}
+
+/*************************************************************************************************************************
+
+This function is called to indicate if wet field found for given field.
+The moisture level stored in field moisture table by background scan is used if measured within moistureReadingMaxAge,
+else moisture sensor of given field is measured.
+Field is wet if moisture level is above configured wet value of field.
+
+ **************************************************************************************************************************/
+_Bool isFieldMoistureSensorWet(unsigned char FieldNo) {
+    unsigned int fieldBit = (unsigned int)1 << FieldNo;
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("isFieldMoistureSensorWet_IN\r\n");
+    //********Debug log#end**************//
+#endif
+    getCurrentTime();
+    if ((fieldMoistureMeasured & fieldBit) && getMinutesElapsed(fieldMoistureDay[FieldNo], fieldMoistureMinute[FieldNo]) < moistureReadingMaxAge) {
+        moisturePeriod = fieldMoisturePeriod[FieldNo];
+        if (fieldMoistureFailed & fieldBit) {
+            moistureSensorFailed = true;
+        }
+        else {
+            moistureSensorFailed = false;
+        }
+    }
+    else {
+        measureFieldMoisture(FieldNo);
+    }
     //For Fertigation sensor 12
     //if (FieldNo == 11) {
     //    if (moistureLevel >= 150) {
@@ -2285,7 +2686,12 @@ _Bool isFieldMoistureSensorWet(unsigned char FieldNo) {
         //    return false;            
         //}
     //}
-    if (moistureLevel >= fieldValve[FieldNo].wetValue) { //Field is full wet, no need to switch ON valve and motor, estimate new due dates
+    // Wet value is converted once after reset, SET converts it on reception
+    if (fieldValve[FieldNo].wetValuePeriod == CLEAR) {
+        fieldValve[FieldNo].wetValuePeriod = getMoisturePeriod(fieldValve[FieldNo].wetValue);
+    }
+    // Frequency above wet value is cycle width below wet value period
+    if (moisturePeriod <= fieldValve[FieldNo].wetValuePeriod) { //Field is full wet, no need to switch ON valve and motor, estimate new due dates
     #ifdef DEBUG_MODE_ON_H
         //********Debug log#start************//
         transmitStringToDebug("isFieldMoistureSensorWet_Yes_Out\r\n");
@@ -2327,9 +2733,16 @@ _Bool isMotorInNoLoad(void) {
     transmitStringToDebug("isMotorInNoLoad_IN\r\n");
     //********Debug log#end**************//
 #endif
-    // Averaging measured pulse width
-    selectChannel(CTchannel);
-    ctOutput = getADCResult();
+    // CT output is not yet sampled for whole window
+    if (!motorCurrentReady) {
+    #ifdef DEBUG_MODE_ON_H
+        //********Debug log#start************//
+        transmitStringToDebug("isMotorInNoLoad_NotReady_OUT\r\n");
+        //********Debug log#end**************//
+    #endif
+        return false;
+    }
+    ctOutput = getAnalogValue(CTchannel); // Filtered RMS value of CT output
     if (ctOutput > temp && ctOutput <= noLoadCutOff) {
         dryRunDetected = true; //Set Low water level
     #ifdef DEBUG_MODE_ON_H
@@ -2377,7 +2790,7 @@ Here ADC module is used to measure high/ low voltage of CT thereby identifying l
 
 void calibrateMotorCurrent(unsigned char loadType, unsigned char FieldNo) {
     unsigned int ctOutput = 0;
-    unsigned char itr = 0, limit = 30;
+    unsigned char itr = 0, limit = 30, digitIndex = 0;
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
     transmitStringToDebug("calibrateMotorCurrent_IN\r\n");
@@ -2435,40 +2848,25 @@ void calibrateMotorCurrent(unsigned char loadType, unsigned char FieldNo) {
         motorPowerTorque = OFF;
     #endif
     }
+    stopMotorCurrentSampling(); // Restart RMS filter of CT output
     myMsDelay(5000);
     // Averaging measured pulse width
     setBCDdigit(0x0F,1); // BCD Indication for Flash
     myMsDelay(5000);
-    selectChannel(CTchannel);
     if (loadType == NoLoad) {
         limit = 11;           //~1.5 min
     }
     for (itr = 0; itr < limit ; itr++) {
-        ctOutput = getADCResult();
+        sampleMotorCurrent(); // Sample CT output for whole mains cycles
+        ctOutput = getAnalogValue(CTchannel);
         myMsDelay(2500);
-        lower8bits = ctOutput;
-        temporaryBytesArray[0] = (unsigned char) ((lower8bits / 1000) + 48);
-        setBCDdigit(temporaryBytesArray[0], 1);
-        myMsDelay(1000);
-        setBCDdigit(0x0F, 1);
-        myMsDelay(500);
-        lower8bits = lower8bits % 1000;
-        temporaryBytesArray[0] = (unsigned char) ((lower8bits / 100) + 48);
-        setBCDdigit(temporaryBytesArray[0], 1);
-        myMsDelay(1000);
-        setBCDdigit(0x0F, 1);
-        myMsDelay(500);
-        lower8bits = lower8bits % 100;
-        temporaryBytesArray[0] = (unsigned char) ((lower8bits / 10) + 48);
-        setBCDdigit(temporaryBytesArray[0], 1);
-        myMsDelay(1000);
-        setBCDdigit(0x0F, 1);
-        myMsDelay(500);
-        lower8bits = lower8bits % 10;
-        temporaryBytesArray[0] = (unsigned char) (lower8bits + 48);
-        setBCDdigit(temporaryBytesArray[0], 1);
-        myMsDelay(1000);
-        setBCDdigit(0x0F, 1);
+        formatNumber(ctOutput, temporaryBytesArray, 4); // Display measured CT output digit by digit
+        for (digitIndex = 0; digitIndex < 4; digitIndex++) {
+            setBCDdigit(temporaryBytesArray[digitIndex], 1);
+            myMsDelay(1000);
+            setBCDdigit(0x0F, 1);
+            myMsDelay(500);
+        }
         if (loadType == FullLoad) {
             fullLoadCutOff = ctOutput;
             noLoadCutOff = (7*fullLoadCutOff)/10;
@@ -2548,9 +2946,7 @@ void doDryRunAction(void) {
     transmitStringToDebug("doDryRunAction_IN\r\n");
     //********Debug log#end**************//
 #endif
-    myMsDelay(100);
-    fetchTimefromRTC(); // Get today's date
-    myMsDelay(100);
+    getCurrentTime(); // Get today's date
 	getDueDate(1); // calculate next day date										 
     for (field_No = 0; field_No < fieldCount; field_No++) {
         if (fieldValve[field_No].status == ON) {
@@ -2595,26 +2991,11 @@ void doDryRunAction(void) {
 					myMsDelay(100);
 					/***********************************************/						 
 					/***************************/
-					// for field no. 01 to 09
-					if (field_No<9){
-						temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-						temporaryBytesArray[1] = field_No + 49; // To store field no. of valve in action 
-					}// for field no. 10 to 12
-					else if (field_No > 8 && field_No < 12) {
-						temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-						temporaryBytesArray[1] = field_No + 39; // To store field no. of valve in action 
-					}
+					formatFieldNo(field_No, temporaryBytesArray); // To store field no. of valve in action
 					/***************************/
 
 					/***************************/
-					sendSms(SmsDR1, userMobileNo, fieldNoRequired); // Acknowledge user about dry run detected and action taken
-				#ifdef SMS_DELIVERY_REPORT_ON_H
-					sleepCount = 2; // Load sleep count for SMS transmission action
-					sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-					setBCDdigit(0x05,0);
-					deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-					setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-				#endif
+					queueSms(SmsDR1, fieldNoRequired, alertDryRun); // Acknowledge user about dry run detected and action taken
 					/***************************/
 				}
 				else if (fieldValve[field_No].fertigationStage == wetPeriod) {
@@ -2627,26 +3008,11 @@ void doDryRunAction(void) {
                     myMsDelay(100);
                     /***********************************************/
                     /***************************/
-                    // for field no. 01 to 09
-                    if (field_No<9){
-                        temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = field_No + 49; // To store field no. of valve in action 
-                    }// for field no. 10 to 12
-                    else if (field_No > 8 && field_No < 12) {
-                        temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = field_No + 39; // To store field no. of valve in action 
-                    }
+                    formatFieldNo(field_No, temporaryBytesArray); // To store field no. of valve in action
                     /***************************/
 
                     /***************************/
-                    sendSms(SmsDR2, userMobileNo, fieldNoRequired); // Acknowledge user about dry run detected and action taken
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
+                    queueSms(SmsDR2, fieldNoRequired, alertDryRun); // Acknowledge user about dry run detected and action taken
                     /***************************/
 				}
 			}
@@ -2661,99 +3027,41 @@ void doDryRunAction(void) {
                     myMsDelay(100);
                     /***********************************************/ 
                     /***************************/
-                    // for field no. 01 to 09
-                    if (field_No<9){
-                        temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = field_No + 49; // To store field no. of valve in action 
-                    }// for field no. 10 to 12
-                    else if (field_No > 8 && field_No < 12) {
-                        temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = field_No + 39; // To store field no. of valve in action 
-                    }
+                    formatFieldNo(field_No, temporaryBytesArray); // To store field no. of valve in action
                     /***************************/
 
                     /***************************/
-					sendSms(SmsDR3, userMobileNo, fieldNoRequired); // Acknowledge user about dry run detected and action taken
-				#ifdef SMS_DELIVERY_REPORT_ON_H
-					sleepCount = 2; // Load sleep count for SMS transmission action
-					sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-					setBCDdigit(0x05,0);
-					deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-					setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-				#endif
+					queueSms(SmsDR3, fieldNoRequired, alertDryRun); // Acknowledge user about dry run detected and action taken
 					/***************************/
                 }
                 else { // next due date
                     /***************************/
-                    // for field no. 01 to 09
-                    if (field_No<9){
-                        temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = field_No + 49; // To store field no. of valve in action 
-                    }// for field no. 10 to 12
-                    else if (field_No > 8 && field_No < 12) {
-                        temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                        temporaryBytesArray[1] = field_No + 39; // To store field no. of valve in action 
-                    }
+                    formatFieldNo(field_No, temporaryBytesArray); // To store field no. of valve in action
                     /***************************/
 
                     /***************************/
-					sendSms(SmsDR4, userMobileNo, fieldNoRequired); // Acknowledge user about dry run detected and action taken
-				#ifdef SMS_DELIVERY_REPORT_ON_H
-					sleepCount = 2; // Load sleep count for SMS transmission action
-					sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-					setBCDdigit(0x05,0);
-					deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-					setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-				#endif
+					queueSms(SmsDR4, fieldNoRequired, alertDryRun); // Acknowledge user about dry run detected and action taken
 					/***************************/
                 }
             }
             if (phaseR) {
                 /***************************/
-                sendSms(SmsPh3, userMobileNo, noInfo); // Acknowledge user about Phase failure detected and action taken
-            #ifdef SMS_DELIVERY_REPORT_ON_H
-                sleepCount = 2; // Load sleep count for SMS transmission action
-                sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                setBCDdigit(0x05,0);
-                deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-            #endif
+                queueSms(SmsPh3, noInfo, alertPhaseFailure); // Acknowledge user about Phase failure detected and action taken
                 /***************************/
             }
             else if (phaseY) {
                 /***************************/
-                sendSms(SmsPh4, userMobileNo, noInfo); // Acknowledge user about Phase failure detected and action taken
-            #ifdef SMS_DELIVERY_REPORT_ON_H
-                sleepCount = 2; // Load sleep count for SMS transmission action
-                sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                setBCDdigit(0x05,0);
-                deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-            #endif
+                queueSms(SmsPh4, noInfo, alertPhaseFailure); // Acknowledge user about Phase failure detected and action taken
                 /***************************/
             }
             else if (phaseB) {
                 /***************************/
-                sendSms(SmsPh5, userMobileNo, noInfo); // Acknowledge user about Phase failure detected and action taken
-            #ifdef SMS_DELIVERY_REPORT_ON_H
-                sleepCount = 2; // Load sleep count for SMS transmission action
-                sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                setBCDdigit(0x05,0);
-                deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-            #endif
+                queueSms(SmsPh5, noInfo, alertPhaseFailure); // Acknowledge user about Phase failure detected and action taken
                 /***************************/
             }
             else {
                 /***************************/
-                sendSms(SmsPh6, userMobileNo, noInfo); // Acknowledge user about Phase failure detected and action taken
-            #ifdef SMS_DELIVERY_REPORT_ON_H
-                sleepCount = 2; // Load sleep count for SMS transmission action
-                sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                setBCDdigit(0x05,0);
-                deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-            #endif
+                queueSms(SmsPh6, noInfo, smsAcknowledgement); // Acknowledge user about Phase failure detected and action taken
                 /***************************/
             }
             
@@ -2799,14 +3107,7 @@ void doLowPhaseAction(void) {
     //********Debug log#end**************//
 #endif
     /***************************/
-    sendSms(SmsPh2, userMobileNo, noInfo); // Acknowledge user about low phase current
-#ifdef SMS_DELIVERY_REPORT_ON_H
-    sleepCount = 2; // Load sleep count for SMS transmission action
-    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-    setBCDdigit(0x05,0);
-    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-#endif
+    queueSms(SmsPh2, noInfo, alertLowPhase); // Acknowledge user about low phase current
     /***************************/
     if (valveDue) {
 		powerOffMotor();
@@ -2828,14 +3129,7 @@ void doLowPhaseAction(void) {
             }
 			
             /***************************/
-            sendSms(SmsFert6, userMobileNo, fieldListRequired); // Acknowledge user about successful Fertigation stopped action due to low phase detection
-        #ifdef SMS_DELIVERY_REPORT_ON_H
-            sleepCount = 2; // Load sleep count for SMS transmission action
-            sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-            setBCDdigit(0x05,0);
-            deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider           
-            setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-        #endif
+            queueSms(SmsFert6, fieldListRequired, smsAcknowledgement); // Acknowledge user about successful Fertigation stopped action due to low phase detection
             /***************************/
         }
     }
@@ -2866,16 +3160,27 @@ void doPhaseFailureAction(void) {
     transmitStringToDebug("doPhaseFailureAction_IN\r\n");
     //********Debug log#end**************//
 #endif
-    /***************************/
-    sendSms(SmsPh1, userMobileNo, noInfo); // Acknowledge user about phase failure
-#ifdef SMS_DELIVERY_REPORT_ON_H
-    sleepCount = 2; // Load sleep count for SMS transmission action
-    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-    setBCDdigit(0x05,0);
-    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-#endif
-    /***************************/
+    // Lost phase is reported in the same alarm, so that one failure is counted once in alert window
+    if (phaseStatus & phaseRLost) {
+        /***************************/
+        queueSms(SmsPh7, noInfo, alertPhaseFailure); // Acknowledge user about Phase R failure
+        /***************************/
+    }
+    else if (phaseStatus & phaseYLost) {
+        /***************************/
+        queueSms(SmsPh8, noInfo, alertPhaseFailure); // Acknowledge user about Phase Y failure
+        /***************************/
+    }
+    else if (phaseStatus & phaseBLost) {
+        /***************************/
+        queueSms(SmsPh9, noInfo, alertPhaseFailure); // Acknowledge user about Phase B failure
+        /***************************/
+    }
+    else {
+        /***************************/
+        queueSms(SmsPh1, noInfo, alertPhaseFailure); // Acknowledge user about phase failure
+        /***************************/
+    }
     if (valveDue) {
 		powerOffMotor();
         iterator = 0;
@@ -2896,14 +3201,7 @@ void doPhaseFailureAction(void) {
             }
 			
             /***************************/
-            sendSms(SmsFert6, userMobileNo, fieldListRequired); // Acknowledge user about successful Fertigation stopped action due to PhaseFailure
-            #ifdef SMS_DELIVERY_REPORT_ON_H
-            sleepCount = 2; // Load sleep count for SMS transmission action
-            sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-            setBCDdigit(0x05,0);
-            deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider           
-            setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-            #endif
+            queueSms(SmsFert6, fieldListRequired, smsAcknowledgement); // Acknowledge user about successful Fertigation stopped action due to PhaseFailure
             /***************************/
         }
     }
@@ -2960,6 +3258,43 @@ void doPhaseFailureAction(void) {
 
 /*********** Phase Failure Action#End********/
 
+/*********** Phase Restore Action#Start********/
+
+/*************************************************************************************************************************
+
+This function is called to perform actions after all phases are back for hold off period.
+After phase restore, resume valves interrupted by phase failure for remaining on period.
+Notify user about all actions
+
+**************************************************************************************************************************/
+
+void doPhaseRestoreAction(void) {
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("doPhaseRestoreAction_IN\r\n");
+    //********Debug log#end**************//
+#endif
+    phaseRestored = false;
+    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
+    /***************************/
+    queueSms(SmsPh6, noInfo, smsAcknowledgement); // Acknowledge user about all phase detected
+    /***************************/
+    if (valveDue && fieldList[0] != 255) {
+        parallelValveFetched = true; // Resume same valve list
+        dueValveChecked = true;
+        iterator = fieldList[0]; // start action from interrupted field irrigation valve
+        sleepCount = readActiveSleepCountFromEeprom(); // Remaining on period of interrupted valve
+    }
+    phaseFailureActionTaken = false;
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("doPhaseRestoreAction_OUT\r\n");
+    //********Debug log#end**************//
+#endif
+}
+
+/*********** Phase Restore Action#End********/
+
 /*********** RTC battery drained#Start********/
 
 /*************************************************************************************************************************
@@ -2981,11 +3316,10 @@ _Bool isRTCBatteryDrained(void) {
     transmitStringToDebug("isRTCBatteryDrained_IN\r\n");
     //********Debug log#end**************//
 #endif
-    selectChannel(RTCchannel);
-    RTC_Trigger = ENABLED;
-    myMsDelay(50);
-    batteryVoltage = getADCResult();
-    RTC_Trigger = DISABLED;
+    if (!analogValueReady) {
+        scanAnalogChannels(); // RTC battery is not measured yet by background scan
+    }
+    batteryVoltage = getAnalogValue(RTCchannel);
     if (batteryVoltage <= batteryVoltageCutoff) {
         lowRTCBatteryDetected = true;
         myMsDelay(100);
@@ -3043,6 +3377,16 @@ _Bool phaseFailure(void) {
     // Falling Edge -- Any one Phase lost
     else {
         // one phase is lost
+        phaseStatus = CLEAR;
+        if (phaseR) {
+            phaseStatus |= phaseRLost;
+        }
+        if (phaseY) {
+            phaseStatus |= phaseYLost;
+        }
+        if (phaseB) {
+            phaseStatus |= phaseBLost;
+        }
         phaseFailureDetected = true; //true
         phaseFailureActionTaken = false;
     #ifdef DEBUG_MODE_ON_H
@@ -3088,7 +3432,7 @@ void powerOnMotor(void) {
     myMsDelay(900);
     motorPowerTorque = OFF;
 #endif
-    
+    stopMotorCurrentSampling(); // Restart RMS filter of CT output for dry run check
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
     transmitStringToDebug("powerOnMotor_OUT\r\n");
@@ -3123,6 +3467,7 @@ void powerOffMotor(void) {
     filtration3ValveControl = OFF; // switch off filtration  valve if it is ON
     myMsDelay(50);
     MotorControl = OFF; // switch off Motor
+    stopMotorCurrentSampling(); // Stop RMS sampling of CT output
     myMsDelay(50);
     
 #ifdef DEBUG_MODE_ON_H
@@ -3304,6 +3649,22 @@ void deepSleep(void) {
 #endif					  
     // check until sleep timer ends given sleep count
     while (sleepCount > 0 && !newSMSRcvd) {
+        // Scan analog channels on each wake up to keep analog value table updated
+        scanAnalogChannels();
+    #ifdef SMS_DELIVERY_REPORT_ON_H
+        // Match delivery report received during sleep and send again failed SMS
+        checkSmsDeliveryReport();
+        retryUndeliveredSms();
+    #endif
+        // Measure moisture sensor of next field on each wake up to keep field moisture table updated
+        if(systemAuthenticated && !phaseFailureDetected) {
+            scanNextFieldMoistureSensor();
+        }
+        // All phases are back after phase failure, wake up to resume actions
+        if(phaseRestored) {
+            doPhaseRestoreAction();
+            break;
+        }
         if(phaseFailureDetected) {
             if(!phaseFailureActionTaken) {
                 doPhaseFailureAction();
@@ -3314,6 +3675,7 @@ void deepSleep(void) {
         // Motor is ON without any external/Internal interrupt
         else if (MotorControl == ON ) {
             saveActiveSleepCountIntoEeprom(); // Save current valve on time
+            sampleMotorCurrent(); // Update filtered motor current before sleep
             // check Motor Dry run condition after each sleep count
             if (isMotorInNoLoad() && dryRunCheckCount > 2) {
                 if (dryRunDetected) {
@@ -3340,11 +3702,19 @@ void deepSleep(void) {
         else if (systemAuthenticated) {
             setBCDdigit(0x01,1);  // (1) BCD Indication for System Authenticated
         }
+        reportSuppressedAlerts(); // Summarize repeated alarms of alert windows which are over
+        flushSmsQueue(); // Send notifications raised before sleep in one SMS
         Run_led = DARK; // Led Indication for system in Sleep/ Idle Mode
         inSleepMode = true; // Indicate in Sleep mode
         WDTCON0bits.SWDTEN = ENABLED; // Enable sleep mode timer
         if(sleepCount > 0 && !newSMSRcvd) {
             Sleep(); // CPU sleep. Wakeup when Watchdog overflows, each of 16 Seconds if value of WDTPS is 4096
+            // Advance system clock if woken up by Watchdog, Timer0 advances it while motor is ON
+            if (MotorControl == OFF && !STATUSbits.nTO) {
+                INTCONbits.GIEL = DISABLED;
+                advanceSystemClock(sleepCountPeriod);
+                INTCONbits.GIEL = ENABLED;
+            }
         }
         if(valveDue) {
             myMsDelay(1500); // compensate for new sms when valve is active
@@ -3359,6 +3729,7 @@ void deepSleep(void) {
         myMsDelay(2000); // To compensate incoming SMS if valve is due within 10 minutes
     }
     inSleepMode = false; // Indicate not in sleep mode
+    flushSmsQueue(); // Send notifications raised on last wake up
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
     transmitStringToDebug("deepSleep_OUT\r\n");
@@ -3402,6 +3773,9 @@ void configureController(void) {
     
     LATC = 0x00;        // Set all output bits to zero for PORTC
     TRISC = 0b10111100; // Set RC<0:1> unused outputs, RC<2:5> as inputs -- Moisture sensor input 9-12, RC<6> as output -- TX1 (WIFI), RC<7> as input -- RX1 (WIFI)
+#ifdef GSM_FLOW_CONTROL_ON_H
+    TRISCbits.TRISC1 = 1; // Set RC<0> as output -- RTS (GSM), RC<1> as input -- CTS (GSM)
+#endif
     WPUC = 0x00;        //Weak Pull-up disabled
     ODCONC = 0x00;      //Output drives both high-going and low-going signals (source and sink current)
     SLRCONC = 0xFF;     //Port pin slew rate is limited
@@ -3465,6 +3839,20 @@ void configureController(void) {
     ADCAP = 0X00;
     ADRPT = 0X00;
     ADACT = 0X00;
+    PIR1bits.ADIF = CLEAR; // Clear ADC Interrupt at start
+    PIE1bits.ADIE = DISABLED; // ADC Interrupt is enabled only during CT sampling
+    IPR1bits.ADIP = LOW; // Low ADC Interrupt Priority
+    PIR1bits.ADTIF = CLEAR; // Clear ADC Threshold Interrupt at start
+    PIE1bits.ADTIE = DISABLED; // ADC Threshold Interrupt is enabled only during background scan
+    IPR1bits.ADTIP = LOW; // Low ADC Threshold Interrupt Priority
+
+    //-----------Timer2_Config (1 msec) used to trigger ADC conversion of CT channel during Motor ON period----------------------//
+
+    T2CLKCON = 0b00000001; // Clock source as FOSC/4
+    T2HLT = 0b00000000; // Free running period mode with software gate
+    T2CON = 0b01100000; // Timer off with 1:64 pre scale and 1:1 post scale
+    T2PR = 249; // 16MHz/64 = 250KHz, 250 counts for 1 msec
+    T2TMR = CLEAR; // Clear Timer2 Register
 
     //-----------Timer0_Config (60 sec) used for SLEEP Count control during Motor ON period and to control filtration  cycle sequence followup----------------------//
     //-----------Timer will not halt in sleep mode------------------------------------------------------//
@@ -3488,6 +3876,17 @@ void configureController(void) {
     PIE5bits.TMR1IE = ENABLED; // Enables the Timer1 Overflow Interrupt
     IPR5bits.TMR1IP = LOW; // Low Timer1 Overflow Interrupt Priority
     
+    //-----------Timer5_Config (5 sec) used as hold off period after change in RYB phase lines----------------------//
+    //-----------Timer will not halt in sleep mode------------------------------------------------------//
+
+    T5CON = 0b00110110; // 16 bit Timer with asynchronous mode with 1:8 pre scale
+    TMR5CLK = 0b00000100; // Clock source as LFINTOSC
+    TMR5H = (unsigned char)(phaseHoldOffCount >> 8); // Load Timer5 Register Higher Byte
+    TMR5L = (unsigned char)(phaseHoldOffCount & 0xFF); // Load Timer5 Register lower Byte
+    PIR5bits.TMR5IF = CLEAR; // Clear Timer5 Overflow Interrupt at start
+    PIE5bits.TMR5IE = ENABLED; // Enables the Timer5 Overflow Interrupt
+    IPR5bits.TMR5IP = LOW; // Low Timer5 Overflow Interrupt Priority
+
     //-----------Timer3_Config (1 sec) used if command fails to respond within timer limit----------------------//
     //-----------Timer will halt in sleep mode------------------------------------------------------//
 
@@ -3529,10 +3928,13 @@ void configureController(void) {
     TX3STA = 0b00100100; // 8 Bit Transmission Enabled with High Baud Rate
     RC3STA = 0b10010000; // 8 Bit Reception Enabled with Continuous Reception
     BAUD3CON = 0b00001000; // 16 Bit Baud Rate Register used
-    SP3BRG = 0x0681; // XTAL=16MHz, Fosc=64Mhz for SYNC=0 BRGH=1 BRG16=1 (Asynchronous high 16 bit baud rate)
+    SP3BRG = gsmBaudRate9600; // XTAL=16MHz, Fosc=64Mhz for SYNC=0 BRGH=1 BRG16=1 (Asynchronous high 16 bit baud rate)
     RE1PPS = 0x21; //EUSART3 Receive
     RE0PPS = 0x10; //EUSART3 Transmit
     temp = RC3REG; // Empty buffer
+#ifdef GSM_FLOW_CONTROL_ON_H
+    gsmRTS = LOW; // Controller is ready to receive from GSM
+#endif
     PIE4bits.RC3IE = ENABLED; // Enables the EUSART Receive Interrupt
     PIE4bits.TX3IE = DISABLED; // Disables the EUSART Transmit Interrupt
     IPR4bits.RC3IP = HIGH; // EUSART Receive Interrupt Priority
@@ -3546,6 +3948,12 @@ void configureController(void) {
     RD6PPS = 0x1B;   //RD6->MSSP2:SCL2;    
     SSP2CLKPPS = 0x1E;   //RD6<-MSSP2:SCL2; 
 	SSP2ADD = 119;
+    PIR3bits.SSP2IF = CLEAR; // Clear MSSP Interrupt at start
+    PIR3bits.BCL2IF = CLEAR; // Clear MSSP Bus Collision Interrupt at start
+    PIE3bits.SSP2IE = ENABLED; // Enables the MSSP Interrupt to follow I2C transaction
+    PIE3bits.BCL2IE = ENABLED; // Enables the MSSP Bus Collision Interrupt
+    IPR3bits.SSP2IP = LOW; // Low MSSP Interrupt Priority
+    IPR3bits.BCL2IP = LOW; // Low MSSP Bus Collision Interrupt Priority
     
     //-----------Interrupt_Config---------------//
     
@@ -3626,6 +4034,7 @@ void actionsOnSystemReset(void) {
         myMsDelay(1000);
         loadDataFromEeprom(); // Read configured valve data saved in EEprom
         myMsDelay(1000);
+        negotiateGsmBaudRate(); // Move GSM link to 115200 baud
         configureGSM(); // Configure GSM in TEXT mode
         myMsDelay(1000);
         setGsmToLocalTime();
@@ -3669,13 +4078,6 @@ void actionsOnSystemReset(void) {
                     msgIndex = CLEAR;
                     /***************************/
                     sendSms(SmsMotor3, userMobileNo, motorLoadRequired);
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/
                 #ifdef DEBUG_MODE_ON_H
                     //********Debug log#start************//
@@ -3696,13 +4098,6 @@ void actionsOnSystemReset(void) {
                     msgIndex = CLEAR;
                     /***************************/
                     sendSms(SmsMotor3, userMobileNo, motorLoadRequired);
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/
                 #ifdef DEBUG_MODE_ON_H
                     //********Debug log#start************//
@@ -3805,22 +4200,22 @@ void actionsOnSystemReset(void) {
     }
     // check if system is authenticated and valve action is due
     if (systemAuthenticated) {
+        // Motor load cut-offs of earlier CT scale are cleared while loading data from EEPROM
+        if (motorLoadCalibrationRequired) {
+            /***************************/
+            queueSms(SmsMotor5, noInfo, smsAcknowledgement); // Acknowledge user to set motor load cut-off again
+            /***************************/
+            motorLoadCalibrationRequired = false;
+        }
         // phase failure detected
         if (phaseFailure()) {                
             sleepCount = 65500;
             /***************************/
-            sendSms(SmsSR01, userMobileNo, noInfo); // Acknowledge user about System restarted with phase failure
-        #ifdef SMS_DELIVERY_REPORT_ON_H
-            sleepCount = 2; // Load sleep count for SMS transmission action
-            sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission 
-            setBCDdigit(0x05,0);
-            deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider 
-            setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-        #endif
+            queueSms(SmsSR01, noInfo, alertPhaseFailure); // Acknowledge user about System restarted with phase failure
             phaseFailureActionTaken = true;
         }
         else {
-            fetchTimefromRTC();
+            getCurrentTime();
             // check if System is configured
             for (iterator = 0; iterator < fieldCount; iterator++) {
                 // check if any field valve status was true after reset
@@ -3879,33 +4274,26 @@ void actionsOnSystemReset(void) {
                 dueValveChecked = true;   
                 switch (resetType) {
                 case PowerOnReset:
-                    sendSms(SmsSR02, userMobileNo, fieldListRequired); // Acknowledge user about system restarted with Valve action
+                    queueSms(SmsSR02, fieldListRequired, smsAcknowledgement); // Acknowledge user about system restarted with Valve action
                     break;
                 case LowPowerReset:
-                    sendSms(SmsSR03, userMobileNo, fieldListRequired); // Acknowledge user about system restarted with Valve action
+                    queueSms(SmsSR03, fieldListRequired, smsAcknowledgement); // Acknowledge user about system restarted with Valve action
                     break;
                 case HardReset:
-                    sendSms(SmsSR04, userMobileNo, fieldListRequired); // Acknowledge user about system restarted with Valve action
+                    queueSms(SmsSR04, fieldListRequired, smsAcknowledgement); // Acknowledge user about system restarted with Valve action
                     break;
                 case SoftResest:
-                    sendSms(SmsSR05, userMobileNo, fieldListRequired); // Acknowledge user about system restarted with Valve action
+                    queueSms(SmsSR05, fieldListRequired, smsAcknowledgement); // Acknowledge user about system restarted with Valve action
                     break;
                 case WDTReset:
-                    sendSms(SmsSR06, userMobileNo, fieldListRequired); // Acknowledge user about system restarted with Valve action
+                    queueSms(SmsSR06, fieldListRequired, smsAcknowledgement); // Acknowledge user about system restarted with Valve action
                     break;
                 case StackReset:
-                    sendSms(SmsSR07, userMobileNo, fieldListRequired); // Acknowledge user about system restarted with Valve action
+                    queueSms(SmsSR07, fieldListRequired, smsAcknowledgement); // Acknowledge user about system restarted with Valve action
                     break;
                 }
                 resetType = CLEAR;
                 /***************************/
-            #ifdef SMS_DELIVERY_REPORT_ON_H
-                sleepCount = 2; // Load sleep count for SMS transmission action
-                sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission 
-                setBCDdigit(0x05,0);
-                deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-            #endif
                 /***************************/
             #ifdef DEBUG_MODE_ON_H
                 //********Debug log#start************//
@@ -3939,13 +4327,6 @@ void actionsOnSystemReset(void) {
                 */
                 resetType = CLEAR;
                 /***************************/
-            #ifdef SMS_DELIVERY_REPORT_ON_H
-                sleepCount = 2; // Load sleep count for SMS transmission action
-                sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission 
-                setBCDdigit(0x05,0);
-                deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider 
-                setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-            #endif
                 /***************************/
             #ifdef DEBUG_MODE_ON_H
                 //********Debug log#start************//
@@ -3974,27 +4355,13 @@ void actionsOnSystemReset(void) {
         if (phaseFailure()) {                
             sleepCount = 65500;
             /***************************/
-            sendSms(SmsAU4, userMobileNo, noInfo); // Acknowledge user about System Authenticated with Phase failure
-        #ifdef SMS_DELIVERY_REPORT_ON_H
-            sleepCount = 2; // Load sleep count for SMS transmission action
-            sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission 
-            setBCDdigit(0x05,0);
-            deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider 
-            setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-        #endif
+            queueSms(SmsAU4, noInfo, alertPhaseFailure); // Acknowledge user about System Authenticated with Phase failure
             phaseFailureActionTaken = true;
         }
     }
     if (isRTCBatteryDrained()) {   
         /***************************/
-        sendSms(SmsRTC1, userMobileNo, noInfo); // Acknowledge user about Please replace RTC battery
-    #ifdef SMS_DELIVERY_REPORT_ON_H
-        sleepCount = 2; // Load sleep count for SMS transmission action
-        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-        setBCDdigit(0x05,0);
-        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-    #endif
+        queueSms(SmsRTC1, noInfo, alertRtcBattery); // Acknowledge user about Please replace RTC battery
         /***************************/
         if(gsmSetToLocalTime) {
             getDateFromGSM(); // Get today's date from Network
@@ -4014,26 +4381,12 @@ void actionsOnSystemReset(void) {
             feedTimeInRTC(); // Feed fetched date from network into RTC
             myMsDelay(1000);
             /***************************/
-            sendSms(SmsRTC3, userMobileNo, noInfo); // Acknowledge user about New RTC battery found, system time is set to local time
-        #ifdef SMS_DELIVERY_REPORT_ON_H
-            sleepCount = 2; // Load sleep count for SMS transmission action
-            sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-            setBCDdigit(0x05,0);
-            deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-            setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-        #endif
+            queueSms(SmsRTC3, noInfo, smsAcknowledgement); // Acknowledge user about New RTC battery found, system time is set to local time
             /***************************/
         }
         else {
             /***************************/
-            sendSms(SmsRTC4, userMobileNo, noInfo); // Acknowledge user about New RTC battery found, please set system time manually to local time
-        #ifdef SMS_DELIVERY_REPORT_ON_H
-            sleepCount = 2; // Load sleep count for SMS transmission action
-            sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-            setBCDdigit(0x05,0);
-            deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-            setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-        #endif
+            queueSms(SmsRTC4, noInfo, smsAcknowledgement); // Acknowledge user about New RTC battery found, please set system time manually to local time
             /***************************/  
         }   
     } 
@@ -4088,20 +4441,7 @@ void actionsOnSleepCountFinish(void) {
                 injector4CycleCnt = CLEAR;
 
                 // Initialize Injectors values to configured values
-                injector1OnPeriod = fieldValve[fieldList[0]].injector1OnPeriod; 
-                injector2OnPeriod = fieldValve[fieldList[0]].injector2OnPeriod; 
-                injector3OnPeriod = fieldValve[fieldList[0]].injector3OnPeriod; 
-                injector4OnPeriod = fieldValve[fieldList[0]].injector4OnPeriod; 
-
-                injector1OffPeriod = fieldValve[fieldList[0]].injector1OffPeriod; 
-                injector2OffPeriod = fieldValve[fieldList[0]].injector2OffPeriod; 
-                injector3OffPeriod = fieldValve[fieldList[0]].injector3OffPeriod; 
-                injector4OffPeriod = fieldValve[fieldList[0]].injector4OffPeriod; 
-
-                injector1Cycle = fieldValve[fieldList[0]].injector1Cycle;
-                injector2Cycle = fieldValve[fieldList[0]].injector2Cycle;
-                injector3Cycle = fieldValve[fieldList[0]].injector3Cycle;
-                injector4Cycle = fieldValve[fieldList[0]].injector4Cycle;
+                loadInjectorProgram(&fieldValve[fieldList[0]]);
 
                 // Initialize injector cycle
                 if(injector1OnPeriod > 0) {
@@ -4152,14 +4492,7 @@ void actionsOnSleepCountFinish(void) {
             saveActiveSleepCountIntoEeprom(); // Save current valve on time 
             myMsDelay(100);
             /***************************/
-            sendSms(SmsFert5, userMobileNo, fieldListRequired); // Acknowledge user about successful Fertigation started action
-        #ifdef SMS_DELIVERY_REPORT_ON_H
-            sleepCount = 2; // Load sleep count for SMS transmission action
-            sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-            setBCDdigit(0x05,0);
-            deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-            setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-        #endif
+            queueSms(SmsFert5, fieldListRequired, smsAcknowledgement); // Acknowledge user about successful Fertigation started action
             /***************************/
 		#ifdef DEBUG_MODE_ON_H
             //********Debug log#start************//
@@ -4196,14 +4529,7 @@ void actionsOnSleepCountFinish(void) {
             saveActiveSleepCountIntoEeprom(); // Save current valve on time 
             myMsDelay(100);
             /***************************/
-            sendSms(SmsFert6, userMobileNo, fieldListRequired); // Acknowledge user about successful Fertigation stopped action
-        #ifdef SMS_DELIVERY_REPORT_ON_H
-            sleepCount = 2; // Load sleep count for SMS transmission action
-            sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-            setBCDdigit(0x05,0);
-            deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider 
-            setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-        #endif
+            queueSms(SmsFert6, fieldListRequired, smsAcknowledgement); // Acknowledge user about successful Fertigation stopped action
             /***************************/
             /*Send sms*/
 		#ifdef DEBUG_MODE_ON_H
@@ -4346,6 +4672,50 @@ void actionsOnSleepCountFinish(void) {
 }
 /*************actionsOnSleepCountFinish#End**********/
 
+/*************skipWetFieldValves#Start**********/
+/*************************************************************************************************************************
+
+This function is called to skip execution of wet field valves
+The purpose of this function is to reschedule valves in valve list for next due date and notify user about wet field.
+
+***************************************************************************************************************************/
+void skipWetFieldValves(void) {
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("skipWetFieldValves_IN\r\n");
+    //********Debug log#end**************//
+#endif
+    // Do action for all simultaneous valve
+    iterator = 0;
+    while(fieldList[iterator] != 255 && iterator < fieldCount) {
+        fieldValve[fieldList[iterator]].status = OFF;
+        fieldValve[fieldList[iterator]].cyclesExecuted = fieldValve[fieldList[iterator]].cycles;
+        myMsDelay(100);
+        getDueDate(fieldValve[fieldList[iterator]].offPeriod); // calculate next due date of valve
+        myMsDelay(100);
+        fieldValve[fieldList[iterator]].nextDueDD = (unsigned char)dueDD;
+        fieldValve[fieldList[iterator]].nextDueMM = dueMM;
+        fieldValve[fieldList[iterator]].nextDueYY = dueYY;
+        myMsDelay(100);
+        saveIrrigationValveOnOffStatusIntoEeprom(eepromAddress[fieldList[iterator]], &fieldValve[fieldList[iterator]]);
+        myMsDelay(100);
+        saveIrrigationValveCycleStatusIntoEeprom(eepromAddress[fieldList[iterator]], &fieldValve[fieldList[iterator]]);
+        myMsDelay(100);
+        saveIrrigationValveDueTimeIntoEeprom(eepromAddress[fieldList[iterator]], &fieldValve[fieldList[iterator]]);
+        myMsDelay(100);
+        iterator++;
+    }
+    /***************************/
+    queueSms(SmsIrr6, fieldListRequired, smsAcknowledgement); // Acknowledge user about Irrigation not started due to wet field detection						
+    /***************************/
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("skipWetFieldValves_OUT\r\n");
+    //********Debug log#end**************//
+#endif
+}
+/*************skipWetFieldValves#End**********/
+
 /*************actionsOnDueValve#Start**********/
 /*************************************************************************************************************************
 
@@ -4355,8 +4725,11 @@ The purpose of this function is to perform actions after valve is due.
 ***************************************************************************************************************************/
 void actionsOnDueValve(unsigned char field_No) {
     unsigned char index = CLEAR;
+    unsigned char dryCount = CLEAR, wetCount = CLEAR, swap = CLEAR;
+    unsigned char wetFieldList[12]; // To store valve list skipped due to wet field
     _Bool valveMatched = false;
 	_Bool valveSwitched = false;
+    _Bool sensorFailed = false;
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
     transmitStringToDebug("actionsOnDueValve_IN\r\n");
@@ -4367,45 +4740,54 @@ void actionsOnDueValve(unsigned char field_No) {
         fetchParallelValveList(field_No);  // find the list of valves which are due/set for same time and on period
     } 
 	parallelValveFetched = false;							 
-    // Check if Moisture sensor is wet (Sensor 1 (0-11)is selected for all fields)
-    if (isFieldMoistureSensorWet(field_No)) {  //Skip current valve execution and go for next
+    // Check moisture of each simultaneous valve with its own field sensor and separate wet valves from list
+    iterator = 0;
+    while(fieldList[iterator] != 255 && iterator < fieldCount) {
+        if (isFieldMoistureSensorWet(fieldList[iterator])) {
+            wetFieldList[wetCount] = fieldList[iterator];
+            wetCount++;
+        }
+        else {
+            if (moistureSensorFailed) {
+                sensorFailed = true; // at least one valve started without moisture check
+            }
+            fieldList[dryCount] = fieldList[iterator];
+            dryCount++;
+        }
+        iterator++;
+    }
+    moistureSensorFailed = sensorFailed;
+    for (index = dryCount; index < fieldCount; index++) {
+        fieldList[index] = 255;
+    }
+    for (index = wetCount; index < fieldCount; index++) {
+        wetFieldList[index] = 255;
+    }
+    if (wetCount > 0) {
+        // Load wet valve list for skipping its execution
+        for (index = 0; index < fieldCount; index++) {
+            swap = fieldList[index];
+            fieldList[index] = wetFieldList[index];
+            wetFieldList[index] = swap;
+        }
+        skipWetFieldValves(); //Skip wet valve execution and notify user
+        // Load back dry valve list for execution
+        if (dryCount > 0) {
+            for (index = 0; index < fieldCount; index++) {
+                fieldList[index] = wetFieldList[index];
+            }
+        }
+    }
+    // All simultaneous valves are wet
+    if (dryCount == 0) {  //Skip current valve execution and go for next
         wetSensor = true;
         valveDue = false;
-        // Do action for all simultaneous valve
-        iterator = 0;
-        while(fieldList[iterator] != 255 && iterator < fieldCount) {
-            fieldValve[fieldList[iterator]].status = OFF;
-            fieldValve[fieldList[iterator]].cyclesExecuted = fieldValve[fieldList[iterator]].cycles;
-            myMsDelay(100);
-            getDueDate(fieldValve[fieldList[iterator]].offPeriod); // calculate next due date of valve
-            myMsDelay(100);
-            fieldValve[fieldList[iterator]].nextDueDD = (unsigned char)dueDD;
-            fieldValve[fieldList[iterator]].nextDueMM = dueMM;
-            fieldValve[fieldList[iterator]].nextDueYY = dueYY;
-            myMsDelay(100);
-            saveIrrigationValveOnOffStatusIntoEeprom(eepromAddress[fieldList[iterator]], &fieldValve[fieldList[iterator]]);
-            myMsDelay(100);
-            saveIrrigationValveCycleStatusIntoEeprom(eepromAddress[fieldList[iterator]], &fieldValve[fieldList[iterator]]);
-            myMsDelay(100);
-            saveIrrigationValveDueTimeIntoEeprom(eepromAddress[fieldList[iterator]], &fieldValve[fieldList[iterator]]);
-            myMsDelay(100);
-            iterator++;
-        }
 		//startFieldNo = field_No;  //+1;                             // scan from same field no.
         nxtPriority = fieldValve[field_No].priority + 1;        // scan for next priority.		
-        /***************************/
-        sendSms(SmsIrr6, userMobileNo, fieldListRequired); // Acknowledge user about Irrigation not started due to wet field detection						
-    #ifdef SMS_DELIVERY_REPORT_ON_H
-        sleepCount = 2; // Load sleep count for SMS transmission action
-        sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-        setBCDdigit(0x05,0);
-        deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-        setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-    #endif
-        /***************************/
     } 
     // All phase present
     else if (!phaseFailure()){
+        field_No = fieldList[0]; // first dry valve in list
         myMsDelay(100);
         // Do action for all simultaneous valve
         iterator = 0;
@@ -4433,26 +4815,12 @@ void actionsOnDueValve(unsigned char field_No) {
             if(moistureSensorFailed) {
                 moistureSensorFailed = false;
                 /***************************/
-                sendSms(SmsMS1, userMobileNo, commonActiveFieldNoRequired);
-            #ifdef SMS_DELIVERY_REPORT_ON_H
-                sleepCount = 2; // Load sleep count for SMS transmission action
-                sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                setBCDdigit(0x05,0);
-                deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-            #endif
+                queueSms(SmsMS1, commonActiveFieldNoRequired, alertMoistureSensor);
                 /***************************/
             }
             else {
                 /***************************/
-                sendSms(SmsIrr4, userMobileNo, commonActiveFieldNoRequired);   // Acknowledge user about successful Irrigation started action
-            #ifdef SMS_DELIVERY_REPORT_ON_H
-                sleepCount = 2; // Load sleep count for SMS transmission action
-                sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                setBCDdigit(0x05,0);
-                deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-            #endif
+                queueSms(SmsIrr4, commonActiveFieldNoRequired, smsAcknowledgement);   // Acknowledge user about successful Irrigation started action
                 /***************************/
             }    
         }
@@ -4480,20 +4848,7 @@ void actionsOnDueValve(unsigned char field_No) {
                 injector4CycleCnt = CLEAR;
 
                 // Initialize Injectors values to configured values
-                injector1OnPeriod = fieldValve[field_No].injector1OnPeriod; 
-                injector2OnPeriod = fieldValve[field_No].injector2OnPeriod; 
-                injector3OnPeriod = fieldValve[field_No].injector3OnPeriod; 
-                injector4OnPeriod = fieldValve[field_No].injector4OnPeriod; 
-
-                injector1OffPeriod = fieldValve[field_No].injector1OffPeriod; 
-                injector2OffPeriod = fieldValve[field_No].injector2OffPeriod; 
-                injector3OffPeriod = fieldValve[field_No].injector3OffPeriod; 
-                injector4OffPeriod = fieldValve[field_No].injector4OffPeriod; 
-
-                injector1Cycle = fieldValve[field_No].injector1Cycle;
-                injector2Cycle = fieldValve[field_No].injector2Cycle;
-                injector3Cycle = fieldValve[field_No].injector3Cycle;
-                injector4Cycle = fieldValve[field_No].injector4Cycle;
+                loadInjectorProgram(&fieldValve[field_No]);
 
                 // Initialize injector cycle
                 if(injector1OnPeriod > 0) {
@@ -4514,14 +4869,7 @@ void actionsOnDueValve(unsigned char field_No) {
                 }
             }
             /***************************/
-            sendSms(SmsFert5, userMobileNo, fieldListRequired); // Acknowledge user about successful Fertigation started action
-        #ifdef SMS_DELIVERY_REPORT_ON_H
-            sleepCount = 2; // Load sleep count for SMS transmission action
-            sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-            setBCDdigit(0x05,0);
-            deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider           
-            setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-        #endif
+            queueSms(SmsFert5, fieldListRequired, smsAcknowledgement); // Acknowledge user about successful Fertigation started action
             /***************************/
         }
         else if (valveExecuted) { // DeActivate previous executed field valve
@@ -4544,14 +4892,7 @@ void actionsOnDueValve(unsigned char field_No) {
             if (valveSwitched) { // Send Sms for only when deactivating executed
                 valveSwitched = false;
                 /***************************/
-                sendSms(SmsIrr5, userMobileNo, commonInActiveFieldNoRequired); // Acknowledge user about successful Irrigation stopped action
-            #ifdef SMS_DELIVERY_REPORT_ON_H
-                sleepCount = 2; // Load sleep count for SMS transmission action
-                sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                setBCDdigit(0x05,0);
-                deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-            #endif
+                queueSms(SmsIrr5, commonInActiveFieldNoRequired, smsAcknowledgement); // Acknowledge user about successful Irrigation stopped action
                 /***************************/
             }
             // Reset De-active Valve list
@@ -4613,13 +4954,6 @@ void deleteUserData(void) {
     //********Debug log#end**************//
 #endif	  
     sendSms(SmsSR14, userMobileNo, noInfo);
-#ifdef SMS_DELIVERY_REPORT_ON_H
-    sleepCount = 2; // Load sleep count for SMS transmission action
-    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission 
-    setBCDdigit(0x05,0);
-    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider 
-    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-#endif
     systemAuthenticated = false;
     saveAuthenticationStatus();
     for (iterator=0; iterator<10; iterator++) {
@@ -4649,13 +4983,6 @@ void deleteValveData(void) {
     //********Debug log#end**************//
 #endif					  
     sendSms(SmsSR14, userMobileNo, noInfo);
-#ifdef SMS_DELIVERY_REPORT_ON_H
-    sleepCount = 2; // Load sleep count for SMS transmission action
-    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission 
-    setBCDdigit(0x05,0);
-    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider 
-    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-#endif
     filtrationDelay1 = 0;
     filtrationDelay2 = 0;
     filtrationDelay3 = 0;
@@ -4729,7 +5056,7 @@ void randomPasswordGeneration(void) {
 /*************************************************************************************************************************
 
 This function is called to clear gsm response string
-The purpose of this function is to enter null values in gsm response
+The purpose of this function is to reset length of gsm response
 
 ***************************************************************************************************************************/
 void clearGsmResponse(void) {
@@ -4738,10 +5065,8 @@ void clearGsmResponse(void) {
     transmitStringToDebug("clearGsmResponse_IN\r\n");
     //********Debug log#end**************//
 #endif
-    // Iterate over the range [0, N]
-    for (iterator = 0; iterator < 220; iterator++) {
-        gsmResponse[iterator] = '\0'; 
-    }
+    gsmResponse[0] = '\0'; // Message is tracked by length, no need to clear whole buffer
+    gsmResponseBuffer.length = CLEAR;
     msgIndex = CLEAR; 
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
@@ -4754,7 +5079,7 @@ void clearGsmResponse(void) {
 /*************************************************************************************************************************
 
 This function is called to clear stringToDecode  string
-The purpose of this function is to enter null values in stringToDecode
+The purpose of this function is to reset length of stringToDecode
 
 ***************************************************************************************************************************/
 void clearStringToDecode(void) { 
@@ -4763,10 +5088,8 @@ void clearStringToDecode(void) {
     transmitStringToDebug("clearStringToDecode_IN\r\n");
     //********Debug log#end**************//
 #endif
-    // Iterate over the range [0, N]
-    for (iterator = 0; iterator < 220; iterator++) {
-        stringToDecode[iterator] = '\0'; 
-    } 
+    stringToDecode[0] = '\0'; // Message is tracked by length, no need to clear whole buffer
+    stringToDecodeBuffer.length = CLEAR;
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
     transmitStringToDebug("clearStringToDecode_OUT\r\n");
@@ -4778,7 +5101,7 @@ void clearStringToDecode(void) {
 /*************************************************************************************************************************
 
 This function is called to clear Decoded string
-The purpose of this function is to enter null values in Decoded string
+The purpose of this function is to reset length of Decoded string
 
 ***************************************************************************************************************************/
 void clearDecodedString(void) {
@@ -4787,10 +5110,8 @@ void clearDecodedString(void) {
     transmitStringToDebug("clearDecodedString_IN\r\n");
     //********Debug log#end**************//
 #endif
-    // Iterate over the range [0, N]
-    for (iterator = 0; iterator < 220; iterator++) {
-        decodedString[iterator] = '\0'; 
-    }  
+    decodedString[0] = '\0'; // Message is tracked by length, no need to clear whole buffer
+    decodedStringBuffer.length = CLEAR;
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
     transmitStringToDebug("clearDecodedString_OUT\r\n");
@@ -23,6 +23,15 @@ void deepSleep(void);                           // Sleep Activity
 _Bool isSystemReady(void);                      // To check system is ready
 _Bool isNumber(unsigned char);                  // To check if variable is number
 _Bool isBase64String(unsigned char *);          // To check if string is base 64 encoded                
+void releaseValvePriority(unsigned char);       // Erase configuration of valves set for given priority
+void scheduleConfiguredValve(unsigned char, unsigned char); // Set due date and reset status of newly configured valve
+void commitConfiguredValves(void);              // Save configuration of released and newly configured valves into EEPROM
+unsigned int getSnapshotCrc(const unsigned char *, unsigned int); // Calculate CRC of configuration snapshot
+_Bool buildConfigurationSnapshot(void);         // Pack configuration of controller into snapshot image
+_Bool decodeSnapshotPart(unsigned char);        // Append base64 text of RESTORE part to snapshot image
+_Bool applyConfigurationSnapshot(void);         // Verify and restore configuration from snapshot image
+void planValveSchedule(unsigned char);          // Simulate valve schedule of given no. of days on copy of valve table
+void extractBinaryCommand(void);                // To execute binary frame received from user
 void extractReceivedSms(void);                  // To extract data received in GSM
 unsigned int days(unsigned char, unsigned char); // To calculate no. of days between 2 dates of calender
 void getDateFromGSM(void);                      // To fetch current time stamp from GSM 
@@ -32,12 +41,21 @@ void activateValve(unsigned char);              // Trigger valve
 void deActivateValve(unsigned char);            // Stop valve
 void powerOnMotor(void);						// Start motor
 void powerOffMotor(void);						// Stop motor
-_Bool isFieldMoistureSensorWet(unsigned char);	// Measure moisture level for field 1 
+_Bool isFieldMoistureSensorWet(unsigned char);	// Check moisture level of given field 
+_Bool isMoistureSensorHigh(unsigned char);      // Read moisture sensor line of given field
+void measureFieldMoisture(unsigned char);       // Measure moisture level of given field
+void saveFieldMoisture(unsigned char);          // Store measured moisture level of given field in field moisture table
+_Bool isMoistureSensorActive(unsigned char);    // Check if moisture sensor of given field changes level
+void scanNextFieldMoistureSensor(void);         // Measure moisture level of next field in round robin
+unsigned int getMoisturePeriod(unsigned int);   // Convert moisture frequency into sensor cycle width
+unsigned int getMoistureLevel(unsigned int);    // Convert sensor cycle width into moisture frequency
+void skipWetFieldValves(void);                  // Skip valve execution for wet fields in valve list
 _Bool isMotorInNoLoad(void);                    // Measure motor CT current
 void calibrateMotorCurrent(unsigned char, unsigned char);      // Calibrate Motor rated current
 void doDryRunAction(void);                      // Take action after detecting Dry Run
 void doLowPhaseAction(void);                    // Take action after detecting Low Phase current
 void doPhaseFailureAction(void);                // Take action after detecting PhaseFailure
+void doPhaseRestoreAction(void);                // Take action after all phases are back
 _Bool isRTCBatteryDrained(void);                // Measure RTC Battery Voltage
 unsigned char fetchFieldNo(unsigned char);      //Fetch field no from sms
 void fetchParallelValveList(unsigned char);     // Find the list of valves which are due/set for same date and time
@@ -47,7 +65,7 @@ void setBCDdigit(unsigned char, _Bool);         // SET BCD digit to number
 void actionsOnSystemReset(void);                // Perform actions on system reset
 void actionsOnSleepCountFinish(void);           // Perform actions on completing sleep count
 void actionsOnDueValve(unsigned char);          // Perform actions on due valve checked
-char *strcpyCustom(char *restrict dest, const char *restrict src); //custom string copy till \n character
+void copyMessageLine(struct MESSAGEBUFFER *, struct MESSAGEBUFFER *, unsigned char); // Copy message line between length tracked buffers
 void deleteUserData(void);                      // Perform User reset action
 void deleteValveData(void);                     // Perform Valve reset action
 void randomPasswordGeneration(void);            // Function to randomly generates password of length 6
@@ -730,6 +730,7 @@ The Action is decided upon Type of message received.
 void extractReceivedSms(void) {
     unsigned char count = CLEAR, onHour = CLEAR, onMinute = CLEAR, fetchedPriority = CLEAR;
     unsigned int digit = CLEAR;
+    struct INJECTORPROGRAM program; // Injector program received in fertigation enable command
 	//timer3Count = 30; // 30 sec window
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
@@ -1091,55 +1092,55 @@ void extractReceivedSms(void) {
                             digit = CLEAR;
                             break;
                         case 4: // code to extract injector1OnPeriod;
-                            fieldValve[iterator].injector1OnPeriod = digit;
+                            program.onPeriod[0] = digit;
                             digit = CLEAR;
                             break;
                         case 5: // code to extract injector1OffPeriod;
-                            fieldValve[iterator].injector1OffPeriod = digit;
+                            program.offPeriod[0] = digit;
                             digit = CLEAR;
                             break;
                         case 6: // code to extract injector1Cycle;
-                            fieldValve[iterator].injector1Cycle = (unsigned char)digit;
+                            program.cycle[0] = (unsigned char)digit;
                             digit = CLEAR;
                             break;
                         case 7: // code to extract injector2OnPeriod;
-                            fieldValve[iterator].injector2OnPeriod = digit;
+                            program.onPeriod[1] = digit;
                             digit = CLEAR;
                             break;
                         case 8: // code to extract injector2OffPeriod;
-                            fieldValve[iterator].injector2OffPeriod = digit;
+                            program.offPeriod[1] = digit;
                             digit = CLEAR;
                             break;
                         case 9: // code to extract injector2Cycle;
-                            fieldValve[iterator].injector2Cycle = (unsigned char)digit;
+                            program.cycle[1] = (unsigned char)digit;
                             digit = CLEAR;
                             break;
                         case 10: // code to extract injector3OnPeriod;
-                            fieldValve[iterator].injector3OnPeriod = digit;
+                            program.onPeriod[2] = digit;
                             digit = CLEAR;
                             break;
                         case 11: // code to extract injector3OffPeriod;
-                            fieldValve[iterator].injector3OffPeriod = digit;
+                            program.offPeriod[2] = digit;
                             digit = CLEAR;
                             break;
                         case 12: // code to extract injector3Cycle;
-                            fieldValve[iterator].injector3Cycle = (unsigned char)digit;
+                            program.cycle[2] = (unsigned char)digit;
                             digit = CLEAR;
                             break;
                         case 13: // code to extract injector4OnPeriod;
-                            fieldValve[iterator].injector4OnPeriod = digit;
+                            program.onPeriod[3] = digit;
                             digit = CLEAR;
                             break;
                         case 14: // code to extract injector4OffPeriod;
-                            fieldValve[iterator].injector4OffPeriod = digit;
+                            program.offPeriod[3] = digit;
                             digit = CLEAR;
                             break;
                         case 15: // code to extract injector1Cycle;
-                            fieldValve[iterator].injector4Cycle = (unsigned char)digit;
+                            program.cycle[3] = (unsigned char)digit;
                             fieldValve[iterator].fertigationStage = OFF;
                             fieldValve[iterator].fertigationValveInterrupted = false;
                             digit = CLEAR;
-                            if ((fieldValve[iterator].fertigationDelay + fieldValve[iterator].fertigationONperiod) >= fieldValve[iterator].onPeriod) {
+                            if ((fieldValve[iterator].fertigationDelay + fieldValve[iterator].fertigationONperiod) >= fieldValve[iterator].onPeriod || !assignInjectorProgram(&fieldValve[iterator], &program)) {
                                 fieldValve[iterator].isFertigationEnabled = false;
                                 /***************************/
                                 // for field no. 01 to 09
@@ -1184,18 +1185,7 @@ void extractReceivedSms(void) {
                                             fieldValve[iterator].fertigationDelay = fieldValve[temp].fertigationDelay;
                                             fieldValve[iterator].fertigationONperiod = fieldValve[temp].fertigationONperiod;
                                             fieldValve[iterator].fertigationInstance = fieldValve[temp].fertigationInstance;
-                                            fieldValve[iterator].injector1OnPeriod = fieldValve[temp].injector1OnPeriod;
-                                            fieldValve[iterator].injector1OffPeriod = fieldValve[temp].injector1OffPeriod;
-                                            fieldValve[iterator].injector1Cycle = fieldValve[temp].injector1Cycle;
-                                            fieldValve[iterator].injector2OnPeriod = fieldValve[temp].injector2OnPeriod;
-                                            fieldValve[iterator].injector2OffPeriod = fieldValve[temp].injector2OffPeriod;
-                                            fieldValve[iterator].injector2Cycle = fieldValve[temp].injector2Cycle;
-                                            fieldValve[iterator].injector3OnPeriod = fieldValve[temp].injector3OnPeriod;
-                                            fieldValve[iterator].injector3OffPeriod = fieldValve[temp].injector3OffPeriod;
-                                            fieldValve[iterator].injector3Cycle = fieldValve[temp].injector3Cycle;
-                                            fieldValve[iterator].injector4OnPeriod = fieldValve[temp].injector4OnPeriod;
-                                            fieldValve[iterator].injector4OffPeriod = fieldValve[temp].injector4OffPeriod;
-                                            fieldValve[iterator].injector4Cycle = fieldValve[temp].injector4Cycle;
+                                            fieldValve[iterator].injectorSlot = fieldValve[temp].injectorSlot;
                                             fieldValve[iterator].fertigationStage = fieldValve[temp].fertigationStage;
                                             fieldValve[iterator].fertigationValveInterrupted = fieldValve[temp].fertigationValveInterrupted;
                                             myMsDelay(100);
@@ -1911,6 +1901,7 @@ void extractReceivedSms(void) {
             fieldValve[iterator].fertigationStage = OFF;
             fieldValve[iterator].fertigationValveInterrupted = false;
             fieldValve[iterator].isFertigationEnabled = true;
+            fieldValve[iterator].injectorSlot = noInjectorProgram; // Injectors are not used in test data
 
             saveIrrigationValveValuesIntoEeprom(eepromAddress[iterator], &fieldValve[iterator]);
             myMsDelay(100);
@@ -3468,6 +3459,12 @@ void configureController(void) {
     RD6PPS = 0x1B;   //RD6->MSSP2:SCL2;    
     SSP2CLKPPS = 0x1E;   //RD6<-MSSP2:SCL2; 
 	SSP2ADD = 119;
+    PIR3bits.SSP2IF = CLEAR; // Clear MSSP Interrupt at start
+    PIR3bits.BCL2IF = CLEAR; // Clear MSSP Bus Collision Interrupt at start
+    PIE3bits.SSP2IE = ENABLED; // Enables the MSSP Interrupt to follow I2C transaction
+    PIE3bits.BCL2IE = ENABLED; // Enables the MSSP Bus Collision Interrupt
+    IPR3bits.SSP2IP = LOW; // Low MSSP Interrupt Priority
+    IPR3bits.BCL2IP = LOW; // Low MSSP Bus Collision Interrupt Priority
     
     //-----------Interrupt_Config---------------//
     
@@ -4063,20 +4060,7 @@ void actionsOnSleepCountFinish(void) {
                 injector4CycleCnt = CLEAR;
 
                 // Initialize Injectors values to configured values
-                injector1OnPeriod = fieldValve[fieldList[0]].injector1OnPeriod; 
-                injector2OnPeriod = fieldValve[fieldList[0]].injector2OnPeriod; 
-                injector3OnPeriod = fieldValve[fieldList[0]].injector3OnPeriod; 
-                injector4OnPeriod = fieldValve[fieldList[0]].injector4OnPeriod; 
-
-                injector1OffPeriod = fieldValve[fieldList[0]].injector1OffPeriod; 
-                injector2OffPeriod = fieldValve[fieldList[0]].injector2OffPeriod; 
-                injector3OffPeriod = fieldValve[fieldList[0]].injector3OffPeriod; 
-                injector4OffPeriod = fieldValve[fieldList[0]].injector4OffPeriod; 
-
-                injector1Cycle = fieldValve[fieldList[0]].injector1Cycle;
-                injector2Cycle = fieldValve[fieldList[0]].injector2Cycle;
-                injector3Cycle = fieldValve[fieldList[0]].injector3Cycle;
-                injector4Cycle = fieldValve[fieldList[0]].injector4Cycle;
+                loadInjectorProgram(&fieldValve[fieldList[0]]);
 
                 // Initialize injector cycle
                 if(injector1OnPeriod > 0) {
@@ -4474,20 +4458,7 @@ void actionsOnDueValve(unsigned char field_No) {
                 injector4CycleCnt = CLEAR;
 
                 // Initialize Injectors values to configured values
-                injector1OnPeriod = fieldValve[field_No].injector1OnPeriod; 
-                injector2OnPeriod = fieldValve[field_No].injector2OnPeriod; 
-                injector3OnPeriod = fieldValve[field_No].injector3OnPeriod; 
-                injector4OnPeriod = fieldValve[field_No].injector4OnPeriod; 
-
-                injector1OffPeriod = fieldValve[field_No].injector1OffPeriod; 
-                injector2OffPeriod = fieldValve[field_No].injector2OffPeriod; 
-                injector3OffPeriod = fieldValve[field_No].injector3OffPeriod; 
-                injector4OffPeriod = fieldValve[field_No].injector4OffPeriod; 
-
-                injector1Cycle = fieldValve[field_No].injector1Cycle;
-                injector2Cycle = fieldValve[field_No].injector2Cycle;
-                injector3Cycle = fieldValve[field_No].injector3Cycle;
-                injector4Cycle = fieldValve[field_No].injector4Cycle;
+                loadInjectorProgram(&fieldValve[field_No]);
 
                 // Initialize injector cycle
                 if(injector1OnPeriod > 0) {
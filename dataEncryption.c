@@ -96,7 +96,7 @@ void base64Decoder() {
     // number of bits in bitstream. 
     unsigned int count_bits = 0,stringLength; 
     setBCDdigit(0x0D,0); // (.) BCD indication for Decryption Action
-    stringLength = strlen((const char *)stringToDecode);
+    stringLength = stringToDecodeBuffer.length;
     // selects 4 characters from 
     // encoded string at a time. 
     // find the position of each stringToDecode 
@@ -147,6 +147,7 @@ void base64Decoder() {
     }
     // place NULL character to mark end of string. 
     decodedString[k] = '\0';  
+    decodedStringBuffer.length = (unsigned char)k;
     setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
 }
 #endif
\ No newline at end of file
@@ -34,9 +34,9 @@ void eepromWrite(unsigned int address, unsigned char data) {
     NVMCON2 = 0x55;
     NVMCON2 = 0xAA;
     NVMCON1bits.WR = SET;
+    INTCONbits.GIE = ENABLED; // Interrupts are masked only for unlock sequence so that GSM reception is serviced during write cycle
     while (NVMCON1bits.WR == SET);
     // ADD indication if infinite
-    INTCONbits.GIE = ENABLED;
     NVMCON1bits.WREN = DISABLED; //disable write operation
 }
 
@@ -56,6 +56,106 @@ unsigned char eepromRead(unsigned int address) {
 }
 //**********************EEPROM Data organization functions_end***************//
 
+//**********************Injector program pool functions_start***************//
+
+/*************************************************************************************************************************
+
+This function is called to assign injector program to fertigation enabled field valve
+The purpose of this function is to store injector program in shared pool and link it to the field valve.
+Valves of same priority share one program and valve with all zero periods does not hold any program.
+
+ **************************************************************************************************************************/
+_Bool assignInjectorProgram(struct FIELDVALVE *fieldptr, const struct INJECTORPROGRAM *programptr) {
+    unsigned char field, slot, injector;
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("assignInjectorProgram_IN\r\n");
+    //********Debug log#end**************//
+#endif
+    for (injector = 0; injector < 4; injector++) {
+        if (programptr->onPeriod[injector] || programptr->offPeriod[injector] || programptr->cycle[injector]) {
+            break;
+        }
+    }
+    // Injectors are not used by this valve
+    if (injector == 4) {
+        fieldptr->injectorSlot = noInjectorProgram;
+#ifdef DEBUG_MODE_ON_H
+        //********Debug log#start************//
+        transmitStringToDebug("assignInjectorProgram_OUT\r\n");
+        //********Debug log#end**************//
+#endif
+        return true;
+    }
+    slot = noInjectorProgram;
+    // Share program of fertigation enabled valve having same priority
+    for (field = 0; field < fieldCount; field++) {
+        if (&fieldValve[field] != fieldptr && fieldValve[field].isFertigationEnabled && fieldValve[field].priority == fieldptr->priority && fieldValve[field].injectorSlot < injectorProgramCount) {
+            slot = fieldValve[field].injectorSlot;
+            break;
+        }
+    }
+    // Else take first program which is not held by any other fertigation enabled valve
+    for (injector = 0; slot == noInjectorProgram && injector < injectorProgramCount; injector++) {
+        for (field = 0; field < fieldCount; field++) {
+            if (&fieldValve[field] != fieldptr && fieldValve[field].isFertigationEnabled && fieldValve[field].injectorSlot == injector) {
+                break;
+            }
+        }
+        if (field == fieldCount) {
+            slot = injector;
+        }
+    }
+    if (slot != noInjectorProgram) {
+        injectorProgram[slot] = *programptr;
+        fieldptr->injectorSlot = slot;
+    }
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("assignInjectorProgram_OUT\r\n");
+    //********Debug log#end**************//
+#endif
+    return (slot != noInjectorProgram);
+}
+
+/*************************************************************************************************************************
+
+This function is called to get injector program of field valve
+The purpose of this function is to return program linked to field valve or all zero program if valve holds none.
+
+ **************************************************************************************************************************/
+const struct INJECTORPROGRAM *getInjectorProgram(struct FIELDVALVE *fieldptr) {
+    if (fieldptr->injectorSlot < injectorProgramCount) {
+        return &injectorProgram[fieldptr->injectorSlot];
+    }
+    return &noInjectorProgramValues;
+}
+
+/*************************************************************************************************************************
+
+This function is called to initialize injectors before fertigation
+The purpose of this function is to load injector periods and cycles of field valve program for injector timer.
+
+ **************************************************************************************************************************/
+void loadInjectorProgram(struct FIELDVALVE *fieldptr) {
+    const struct INJECTORPROGRAM *programptr = getInjectorProgram(fieldptr);
+    injector1OnPeriod = programptr->onPeriod[0];
+    injector2OnPeriod = programptr->onPeriod[1];
+    injector3OnPeriod = programptr->onPeriod[2];
+    injector4OnPeriod = programptr->onPeriod[3];
+
+    injector1OffPeriod = programptr->offPeriod[0];
+    injector2OffPeriod = programptr->offPeriod[1];
+    injector3OffPeriod = programptr->offPeriod[2];
+    injector4OffPeriod = programptr->offPeriod[3];
+
+    injector1Cycle = programptr->cycle[0];
+    injector2Cycle = programptr->cycle[1];
+    injector3Cycle = programptr->cycle[2];
+    injector4Cycle = programptr->cycle[3];
+}
+//**********************Injector program pool functions_end***************//
+
 //************************read structures from eeprom_start*************************//
 
 /*************************************************************************************************************************
@@ -73,27 +173,27 @@ void saveIrrigationValveValuesIntoEeprom(unsigned int address, struct FIELDVALVE
 #endif
     //setBCDdigit(0x04,0); //  "4." BCD Indication for EEPROM Memory Write Operation
     myMsDelay(50);
-    eepromWrite(address, fieldptr->dryValue & 0xFF);
+    eepromWrite(address + valveDryValueOffset, fieldptr->dryValue & 0xFF);
     myMsDelay(50);
-    eepromWrite(address + 1, (fieldptr->dryValue >> 8) & 0xFF);
+    eepromWrite(address + valveDryValueOffset + 1, (fieldptr->dryValue >> 8) & 0xFF);
     myMsDelay(50);
-    eepromWrite(address + 2, fieldptr->wetValue & 0xFF);
+    eepromWrite(address + valveWetValueOffset, fieldptr->wetValue & 0xFF);
     myMsDelay(50);
-    eepromWrite(address + 3, (fieldptr->wetValue >> 8) & 0xFF);
+    eepromWrite(address + valveWetValueOffset + 1, (fieldptr->wetValue >> 8) & 0xFF);
     myMsDelay(50);
-    eepromWrite(address + 4, fieldptr->onPeriod & 0xFF);
+    eepromWrite(address + valveOnPeriodOffset, fieldptr->onPeriod & 0xFF);
     myMsDelay(50);
-    eepromWrite(address + 5, (fieldptr->onPeriod >> 8) & 0xFF);
+    eepromWrite(address + valveOnPeriodOffset + 1, (fieldptr->onPeriod >> 8) & 0xFF);
     myMsDelay(50);
-    eepromWrite(address + 30, fieldptr->offPeriod);
+    eepromWrite(address + valveOffPeriodOffset, fieldptr->offPeriod);
     myMsDelay(50);
-    eepromWrite(address + 31, fieldptr->motorOnTimeHour);
+    eepromWrite(address + valveMotorOnHourOffset, fieldptr->motorOnTimeHour);
     myMsDelay(50);
-    eepromWrite(address + 32, fieldptr->motorOnTimeMinute);
+    eepromWrite(address + valveMotorOnMinuteOffset, fieldptr->motorOnTimeMinute);
     myMsDelay(50);
-    eepromWrite(address + 37, fieldptr->priority);
+    eepromWrite(address + valvePriorityOffset, fieldptr->priority);
     myMsDelay(50);
-    eepromWrite(address + 39, fieldptr->cycles);
+    eepromWrite(address + valveCyclesOffset, fieldptr->cycles);
     myMsDelay(50);
     //setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
 #ifdef DEBUG_MODE_ON_H
@@ -110,6 +210,8 @@ The purpose of this function is to load entire Field fertigation valve structure
  **************************************************************************************************************************/
 //Write field structure into eeprom 
 void saveFertigationValveValuesIntoEeprom(unsigned int address, struct FIELDVALVE *fieldptr) {
+    const struct INJECTORPROGRAM *programptr;
+    unsigned char injector;
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
     transmitStringToDebug("saveFertigationValveValuesIntoEeprom_IN\r\n");
@@ -117,61 +219,37 @@ void saveFertigationValveValuesIntoEeprom(unsigned int address, struct FIELDVALV
 #endif
     //setBCDdigit(0x04,0); //  "4." BCD Indication for EEPROM Memory Write Operation
     myMsDelay(50);
-    eepromWrite(address + 6, fieldptr->fertigationDelay & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 7, (fieldptr->fertigationDelay >> 8) & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 8, fieldptr->fertigationONperiod & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 9, (fieldptr->fertigationONperiod >> 8) & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 10, fieldptr->injector1OnPeriod & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 11, (fieldptr->injector1OnPeriod >> 8) & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 12, fieldptr->injector2OnPeriod & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 13, (fieldptr->injector2OnPeriod >> 8) & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 14, fieldptr->injector3OnPeriod & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 15, (fieldptr->injector3OnPeriod >> 8) & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 16, fieldptr->injector4OnPeriod & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 17, (fieldptr->injector4OnPeriod >> 8) & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 18, fieldptr->injector1OffPeriod & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 19, (fieldptr->injector1OffPeriod >> 8) & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 20, fieldptr->injector2OffPeriod & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 21, (fieldptr->injector2OffPeriod >> 8) & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 22, fieldptr->injector3OffPeriod & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 23, (fieldptr->injector3OffPeriod >> 8) & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 24, fieldptr->injector4OffPeriod & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 25, (fieldptr->injector4OffPeriod >> 8) & 0xFF);
-    myMsDelay(50);
-    eepromWrite(address + 26, fieldptr->injector1Cycle);
-    myMsDelay(50);
-    eepromWrite(address + 27, fieldptr->injector2Cycle);
-    myMsDelay(50);
-    eepromWrite(address + 28, fieldptr->injector3Cycle);
-    myMsDelay(50);
-    eepromWrite(address + 29, fieldptr->injector4Cycle);
-    myMsDelay(50);
-    eepromWrite(address + 36, fieldptr->fertigationInstance);
+    eepromWrite(address + valveFertigationDelayOffset, fieldptr->fertigationDelay & 0xFF);
+    myMsDelay(50);
+    eepromWrite(address + valveFertigationDelayOffset + 1, (fieldptr->fertigationDelay >> 8) & 0xFF);
+    myMsDelay(50);
+    eepromWrite(address + valveFertigationOnPeriodOffset, fieldptr->fertigationONperiod & 0xFF);
+    myMsDelay(50);
+    eepromWrite(address + valveFertigationOnPeriodOffset + 1, (fieldptr->fertigationONperiod >> 8) & 0xFF);
+    myMsDelay(50);
+    // Injector program is saved only for enabled valve, held valve keeps its last saved program
+    if (fieldptr->isFertigationEnabled) {
+        programptr = getInjectorProgram(fieldptr);
+        for (injector = 0; injector < 4; injector++) {
+            eepromWrite(address + valveInjectorOnPeriodOffset + (injector << 1), programptr->onPeriod[injector] & 0xFF);
+            myMsDelay(50);
+            eepromWrite(address + valveInjectorOnPeriodOffset + 1 + (injector << 1), (programptr->onPeriod[injector] >> 8) & 0xFF);
+            myMsDelay(50);
+            eepromWrite(address + valveInjectorOffPeriodOffset + (injector << 1), programptr->offPeriod[injector] & 0xFF);
+            myMsDelay(50);
+            eepromWrite(address + valveInjectorOffPeriodOffset + 1 + (injector << 1), (programptr->offPeriod[injector] >> 8) & 0xFF);
+            myMsDelay(50);
+            eepromWrite(address + valveInjectorCycleOffset + injector, programptr->cycle[injector]);
+            myMsDelay(50);
+        }
+    }
+    eepromWrite(address + valveFertigationInstanceOffset, fieldptr->fertigationInstance);
     myMsDelay(50);
-    eepromWrite(address + 38, fieldptr->fertigationStage);
+    eepromWrite(address + valveFertigationStageOffset, fieldptr->fertigationStage);
     myMsDelay(50);
-    eepromWrite(address + 43, fieldptr->isFertigationEnabled);
+    eepromWrite(address + valveIsFertigationEnabledOffset, fieldptr->isFertigationEnabled);
     myMsDelay(50);
-    eepromWrite(address + 44, fieldptr->fertigationValveInterrupted);
+    eepromWrite(address + valveFertigationInterruptedOffset, fieldptr->fertigationValveInterrupted);
     myMsDelay(50);
     //setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
 #ifdef DEBUG_MODE_ON_H
@@ -196,11 +274,11 @@ void saveIrrigationValveDueTimeIntoEeprom(unsigned int address, struct FIELDVALV
 #endif
     //setBCDdigit(0x04,0); //  "4." BCD Indication for EEPROM Memory Write Operation
     myMsDelay(50);
-    eepromWrite(address + 33, fieldptr->nextDueDD);
+    eepromWrite(address + valveNextDueDDOffset, fieldptr->nextDueDD);
     myMsDelay(50);
-    eepromWrite(address + 34, fieldptr->nextDueMM);
+    eepromWrite(address + valveNextDueMMOffset, fieldptr->nextDueMM);
     myMsDelay(50);
-    eepromWrite(address + 35, fieldptr->nextDueYY);
+    eepromWrite(address + valveNextDueYYOffset, fieldptr->nextDueYY);
     myMsDelay(50);
     //setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
 #ifdef DEBUG_MODE_ON_H
@@ -225,7 +303,7 @@ void saveIrrigationValveOnOffStatusIntoEeprom(unsigned int address, struct FIELD
 #endif
     //setBCDdigit(0x04,0); //  "4." BCD Indication for EEPROM Memory Write Operation
     myMsDelay(50);
-    eepromWrite(address + 41, fieldptr->status);
+    eepromWrite(address + valveStatusOffset, fieldptr->status);
     myMsDelay(50);
     //setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
 #ifdef DEBUG_MODE_ON_H
@@ -250,7 +328,7 @@ void saveIrrigationValveCycleStatusIntoEeprom(unsigned int address, struct FIELD
 #endif
     //setBCDdigit(0x04,0); //  "4." BCD Indication for EEPROM Memory Write Operation
     myMsDelay(50);
-    eepromWrite(address + 40, fieldptr->cyclesExecuted);
+    eepromWrite(address + valveCyclesExecutedOffset, fieldptr->cyclesExecuted);
     myMsDelay(50);
     //setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
 #ifdef DEBUG_MODE_ON_H
@@ -275,11 +353,11 @@ void saveFertigationValveStatusIntoEeprom(unsigned int address, struct FIELDVALV
 #endif
     //setBCDdigit(0x04,0); //  "4." BCD Indication for EEPROM Memory Write Operation
     myMsDelay(50);
-    eepromWrite(address + 36, fieldptr->fertigationInstance);
+    eepromWrite(address + valveFertigationInstanceOffset, fieldptr->fertigationInstance);
     myMsDelay(50);
-    eepromWrite(address + 38, fieldptr->fertigationStage);
+    eepromWrite(address + valveFertigationStageOffset, fieldptr->fertigationStage);
     myMsDelay(50);
-    eepromWrite(address + 44, fieldptr->fertigationValveInterrupted);
+    eepromWrite(address + valveFertigationInterruptedOffset, fieldptr->fertigationValveInterrupted);
     myMsDelay(50);
     //setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
 #ifdef DEBUG_MODE_ON_H
@@ -304,7 +382,7 @@ void saveIrrigationValveConfigurationStatusIntoEeprom(unsigned int address, stru
 #endif
     //setBCDdigit(0x04,0); //  "4." BCD Indication for EEPROM Memory Write Operation
     myMsDelay(50);
-    eepromWrite(address + 42, fieldptr->isConfigured);
+    eepromWrite(address + valveIsConfiguredOffset, fieldptr->isConfigured);
     myMsDelay(50);
     //setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
 #ifdef DEBUG_MODE_ON_H
@@ -329,7 +407,7 @@ void saveIrrigationValvePriorityIntoEeprom(unsigned int address, struct FIELDVAL
 #endif
     //setBCDdigit(0x04,0); //  "4." BCD Indication for EEPROM Memory Write Operation
     myMsDelay(50);
-    eepromWrite(address + 37, fieldptr->priority);
+    eepromWrite(address + valvePriorityOffset, fieldptr->priority);
     myMsDelay(50);
     //setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
 #ifdef DEBUG_MODE_ON_H
@@ -341,157 +419,175 @@ void saveIrrigationValvePriorityIntoEeprom(unsigned int address, struct FIELDVAL
 
 /*************************************************************************************************************************
 
+This function is called to commit field valve configuration into EEPROM memory in one batch
+The purpose of this function is to write all configuration bytes of Field valve back to back without settling delays,
+as eepromWrite returns only after write cycle is complete and keeps interrupts enabled while write cycle is in progress.
+Configuration status is cleared first and written last so that valve interrupted in between is loaded as not configured.
+
+ **************************************************************************************************************************/
+//Write field structure into eeprom 
+void commitIrrigationValveConfigurationIntoEeprom(unsigned int address, struct FIELDVALVE *fieldptr) {
+    const struct INJECTORPROGRAM *programptr;
+    unsigned char injector;
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("commitIrrigationValveConfigurationIntoEeprom_IN\r\n");
+    //********Debug log#end**************//
+#endif
+    eepromWrite(address + valveIsConfiguredOffset, false);
+    eepromWrite(address + valveDryValueOffset, fieldptr->dryValue & 0xFF);
+    eepromWrite(address + valveDryValueOffset + 1, (fieldptr->dryValue >> 8) & 0xFF);
+    eepromWrite(address + valveWetValueOffset, fieldptr->wetValue & 0xFF);
+    eepromWrite(address + valveWetValueOffset + 1, (fieldptr->wetValue >> 8) & 0xFF);
+    eepromWrite(address + valveOnPeriodOffset, fieldptr->onPeriod & 0xFF);
+    eepromWrite(address + valveOnPeriodOffset + 1, (fieldptr->onPeriod >> 8) & 0xFF);
+    eepromWrite(address + valveFertigationDelayOffset, fieldptr->fertigationDelay & 0xFF);
+    eepromWrite(address + valveFertigationDelayOffset + 1, (fieldptr->fertigationDelay >> 8) & 0xFF);
+    eepromWrite(address + valveFertigationOnPeriodOffset, fieldptr->fertigationONperiod & 0xFF);
+    eepromWrite(address + valveFertigationOnPeriodOffset + 1, (fieldptr->fertigationONperiod >> 8) & 0xFF);
+    // Injector program is saved only for enabled valve, held valve keeps its last saved program
+    if (fieldptr->isFertigationEnabled) {
+        programptr = getInjectorProgram(fieldptr);
+        for (injector = 0; injector < 4; injector++) {
+            eepromWrite(address + valveInjectorOnPeriodOffset + (injector << 1), programptr->onPeriod[injector] & 0xFF);
+            eepromWrite(address + valveInjectorOnPeriodOffset + 1 + (injector << 1), (programptr->onPeriod[injector] >> 8) & 0xFF);
+            eepromWrite(address + valveInjectorOffPeriodOffset + (injector << 1), programptr->offPeriod[injector] & 0xFF);
+            eepromWrite(address + valveInjectorOffPeriodOffset + 1 + (injector << 1), (programptr->offPeriod[injector] >> 8) & 0xFF);
+            eepromWrite(address + valveInjectorCycleOffset + injector, programptr->cycle[injector]);
+        }
+    }
+    eepromWrite(address + valveOffPeriodOffset, fieldptr->offPeriod);
+    eepromWrite(address + valveMotorOnHourOffset, fieldptr->motorOnTimeHour);
+    eepromWrite(address + valveMotorOnMinuteOffset, fieldptr->motorOnTimeMinute);
+    eepromWrite(address + valveNextDueDDOffset, fieldptr->nextDueDD);
+    eepromWrite(address + valveNextDueMMOffset, fieldptr->nextDueMM);
+    eepromWrite(address + valveNextDueYYOffset, fieldptr->nextDueYY);
+    eepromWrite(address + valveFertigationInstanceOffset, fieldptr->fertigationInstance);
+    eepromWrite(address + valvePriorityOffset, fieldptr->priority);
+    eepromWrite(address + valveFertigationStageOffset, fieldptr->fertigationStage);
+    eepromWrite(address + valveCyclesOffset, fieldptr->cycles);
+    eepromWrite(address + valveCyclesExecutedOffset, fieldptr->cyclesExecuted);
+    eepromWrite(address + valveStatusOffset, fieldptr->status);
+    eepromWrite(address + valveIsFertigationEnabledOffset, fieldptr->isFertigationEnabled);
+    eepromWrite(address + valveFertigationInterruptedOffset, fieldptr->fertigationValveInterrupted);
+    eepromWrite(address + valveIsConfiguredOffset, fieldptr->isConfigured);
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("commitIrrigationValveConfigurationIntoEeprom_OUT\r\n");
+    //********Debug log#end**************//
+#endif
+}
+
+/*************************************************************************************************************************
+
 This function is called to read field valve configuration from EEPROM memory
 The purpose of this function is to load entire Field valve structure from the assigned EEPROM memory
 
  **************************************************************************************************************************/
 //Read field structure from eeprom 
 void readValveDataFromEeprom(unsigned int address, struct FIELDVALVE *fieldptr){
+    struct INJECTORPROGRAM program;
+    unsigned char injector;
     //setBCDdigit(0x04,1); // "4" BCD Indication for EEPROM Memory Read Operation
     myMsDelay(50);
-    lower8bits = eepromRead(address);
+    lower8bits = eepromRead(address + valveDryValueOffset);
     myMsDelay(50);
     lower8bits &= 0x00FF;
-    higher8bits = eepromRead(address + 1);
+    higher8bits = eepromRead(address + valveDryValueOffset + 1);
     myMsDelay(50);
     higher8bits <<= 8;
     higher8bits &= 0xFF00;
     fieldptr->dryValue = ((lower8bits) | (higher8bits));
-    lower8bits = eepromRead(address + 2);
+    lower8bits = eepromRead(address + valveWetValueOffset);
     myMsDelay(50);
     lower8bits &= 0x00FF;
-    higher8bits = eepromRead(address + 3);
+    higher8bits = eepromRead(address + valveWetValueOffset + 1);
     myMsDelay(50);
     higher8bits <<= 8;
     higher8bits &= 0xFF00;
     fieldptr->wetValue = ((lower8bits) | (higher8bits));
-    lower8bits = eepromRead(address + 4);
+    fieldptr->wetValuePeriod = CLEAR; // Converted on next moisture check
+    lower8bits = eepromRead(address + valveOnPeriodOffset);
     myMsDelay(50);
     lower8bits &= 0x00FF;
-    higher8bits = eepromRead(address + 5);
+    higher8bits = eepromRead(address + valveOnPeriodOffset + 1);
     myMsDelay(50);
     higher8bits <<= 8;
     higher8bits &= 0xFF00;
     fieldptr->onPeriod = ((lower8bits) | (higher8bits));
     myMsDelay(50);
-    lower8bits = eepromRead(address + 6);
+    lower8bits = eepromRead(address + valveFertigationDelayOffset);
     myMsDelay(50);
     lower8bits &= 0x00FF;
-    higher8bits = eepromRead(address + 7);
+    higher8bits = eepromRead(address + valveFertigationDelayOffset + 1);
     higher8bits <<= 8;
     higher8bits &= 0xFF00;
     fieldptr->fertigationDelay = ((lower8bits) | (higher8bits));
     myMsDelay(50);
-    lower8bits = eepromRead(address + 8);
+    lower8bits = eepromRead(address + valveFertigationOnPeriodOffset);
     myMsDelay(50);
     lower8bits &= 0x00FF;
-    higher8bits = eepromRead(address + 9);
+    higher8bits = eepromRead(address + valveFertigationOnPeriodOffset + 1);
     higher8bits <<= 8;
     higher8bits &= 0xFF00;
     fieldptr->fertigationONperiod = ((lower8bits) | (higher8bits));
     myMsDelay(50);
-    lower8bits = eepromRead(address + 10);
+    fieldptr->offPeriod = eepromRead(address + valveOffPeriodOffset);
     myMsDelay(50);
-    lower8bits &= 0x00FF;
-    higher8bits = eepromRead(address + 11);
-    higher8bits <<= 8;
-    higher8bits &= 0xFF00;
-    fieldptr->injector1OnPeriod = ((lower8bits) | (higher8bits));
+    fieldptr->motorOnTimeHour = eepromRead(address + valveMotorOnHourOffset);
     myMsDelay(50);
-    lower8bits = eepromRead(address + 12);
+    fieldptr->motorOnTimeMinute = eepromRead(address + valveMotorOnMinuteOffset);
     myMsDelay(50);
-    lower8bits &= 0x00FF;
-    higher8bits = eepromRead(address + 13);
-    higher8bits <<= 8;
-    higher8bits &= 0xFF00;
-    fieldptr->injector2OnPeriod = ((lower8bits) | (higher8bits));
+    fieldptr->nextDueDD = eepromRead(address + valveNextDueDDOffset);
     myMsDelay(50);
-    lower8bits = eepromRead(address + 14);
+    fieldptr->nextDueMM = eepromRead(address + valveNextDueMMOffset);
     myMsDelay(50);
-    lower8bits &= 0x00FF;
-    higher8bits = eepromRead(address + 15);
-    higher8bits <<= 8;
-    higher8bits &= 0xFF00;
-    fieldptr->injector3OnPeriod = ((lower8bits) | (higher8bits));
+    fieldptr->nextDueYY = eepromRead(address + valveNextDueYYOffset);
     myMsDelay(50);
-    lower8bits = eepromRead(address + 16);
+    fieldptr->fertigationInstance = eepromRead(address + valveFertigationInstanceOffset);
     myMsDelay(50);
-    lower8bits &= 0x00FF;
-    higher8bits = eepromRead(address + 17);
-    higher8bits <<= 8;
-    higher8bits &= 0xFF00;
-    fieldptr->injector4OnPeriod = ((lower8bits) | (higher8bits));
+    fieldptr->priority = eepromRead(address + valvePriorityOffset);
     myMsDelay(50);
-    lower8bits = eepromRead(address + 18);
+    fieldptr->fertigationStage = eepromRead(address + valveFertigationStageOffset);
     myMsDelay(50);
-    lower8bits &= 0x00FF;
-    higher8bits = eepromRead(address + 19);
-    higher8bits <<= 8;
-    higher8bits &= 0xFF00;
-    fieldptr->injector1OffPeriod = ((lower8bits) | (higher8bits));
+    fieldptr->cycles = eepromRead(address + valveCyclesOffset);
     myMsDelay(50);
-    lower8bits = eepromRead(address + 20);
+    fieldptr->cyclesExecuted = eepromRead(address + valveCyclesExecutedOffset);
     myMsDelay(50);
-    lower8bits &= 0x00FF;
-    higher8bits = eepromRead(address + 21);
-    higher8bits <<= 8;
-    higher8bits &= 0xFF00;
-    fieldptr->injector2OffPeriod = ((lower8bits) | (higher8bits));
-    myMsDelay(50);
-    lower8bits = eepromRead(address + 22);
-    myMsDelay(50);
-    lower8bits &= 0x00FF;
-    higher8bits = eepromRead(address + 23);
-    higher8bits <<= 8;
-    higher8bits &= 0xFF00;
-    fieldptr->injector3OffPeriod = ((lower8bits) | (higher8bits));
-    myMsDelay(50);
-    lower8bits = eepromRead(address + 24);
-    myMsDelay(50);
-    lower8bits &= 0x00FF;
-    higher8bits = eepromRead(address + 25);
-    higher8bits <<= 8;
-    higher8bits &= 0xFF00;
-    fieldptr->injector4OffPeriod = ((lower8bits) | (higher8bits));
-    myMsDelay(50);
-    fieldptr->injector1Cycle = eepromRead(address + 26);
-    myMsDelay(50);
-    fieldptr->injector2Cycle = eepromRead(address + 27);
-    myMsDelay(50);
-    fieldptr->injector3Cycle = eepromRead(address + 28);
-    myMsDelay(50);
-    fieldptr->injector4Cycle = eepromRead(address + 29);
-    myMsDelay(50);    
-    fieldptr->offPeriod = eepromRead(address + 30);
-    myMsDelay(50);
-    fieldptr->motorOnTimeHour = eepromRead(address + 31);
-    myMsDelay(50);
-    fieldptr->motorOnTimeMinute = eepromRead(address + 32);
-    myMsDelay(50);
-    fieldptr->nextDueDD = eepromRead(address + 33);
-    myMsDelay(50);
-    fieldptr->nextDueMM = eepromRead(address + 34);
-    myMsDelay(50);
-    fieldptr->nextDueYY = eepromRead(address + 35);
-    myMsDelay(50);
-    fieldptr->fertigationInstance = eepromRead(address + 36);
-    myMsDelay(50);
-    fieldptr->priority = eepromRead(address + 37);
+    fieldptr->status = eepromRead(address + valveStatusOffset);
     myMsDelay(50);
-    fieldptr->fertigationStage = eepromRead(address + 38);
+    fieldptr->isConfigured = eepromRead(address + valveIsConfiguredOffset);
     myMsDelay(50);
-    fieldptr->cycles = eepromRead(address + 39);
+    fieldptr->isFertigationEnabled = eepromRead(address + valveIsFertigationEnabledOffset);
     myMsDelay(50);
-    fieldptr->cyclesExecuted = eepromRead(address + 40);
-    myMsDelay(50);
-    fieldptr->status = eepromRead(address + 41);
-    myMsDelay(50);
-    fieldptr->isConfigured = eepromRead(address + 42);
-    myMsDelay(50);
-    fieldptr->isFertigationEnabled = eepromRead(address + 43);
-    myMsDelay(50);
-    fieldptr->fertigationValveInterrupted = eepromRead(address + 44);
+    fieldptr->fertigationValveInterrupted = eepromRead(address + valveFertigationInterruptedOffset);
     myMsDelay(50);    
+    // Injector program is loaded into pool only for fertigation enabled valve
+    if (fieldptr->isFertigationEnabled) {
+        for (injector = 0; injector < 4; injector++) {
+            lower8bits = eepromRead(address + valveInjectorOnPeriodOffset + (injector << 1));
+            myMsDelay(50);
+            lower8bits &= 0x00FF;
+            higher8bits = eepromRead(address + valveInjectorOnPeriodOffset + 1 + (injector << 1));
+            higher8bits <<= 8;
+            higher8bits &= 0xFF00;
+            program.onPeriod[injector] = ((lower8bits) | (higher8bits));
+            myMsDelay(50);
+            lower8bits = eepromRead(address + valveInjectorOffPeriodOffset + (injector << 1));
+            myMsDelay(50);
+            lower8bits &= 0x00FF;
+            higher8bits = eepromRead(address + valveInjectorOffPeriodOffset + 1 + (injector << 1));
+            higher8bits <<= 8;
+            higher8bits &= 0xFF00;
+            program.offPeriod[injector] = ((lower8bits) | (higher8bits));
+            myMsDelay(50);
+            program.cycle[injector] = eepromRead(address + valveInjectorCycleOffset + injector);
+            myMsDelay(50);
+        }
+        if (!assignInjectorProgram(fieldptr, &program)) {
+            fieldptr->isFertigationEnabled = false; // No free injector program, fertigation is to be enabled again
+        }
+    }
     //setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
 }
 
@@ -669,6 +765,8 @@ void saveMotorLoadValuesIntoEeprom(void) {
     myMsDelay(50);
     eepromWrite(eepromAddress[forSystem] + 12, (fullLoadCutOff >> 8) & 0xFF); //HIGHER 8 BIT
     myMsDelay(50);
+    eepromWrite(eepromAddress[forSystem] + 13, motorLoadScaleVersion); // Scale of saved cut-offs
+    myMsDelay(50);
     //setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
@@ -702,6 +800,13 @@ void readMotorLoadValuesFromEeprom(void){
     higher8bits &= 0xFF00;
     fullLoadCutOff = ((lower8bits) | (higher8bits));
     myMsDelay(50);  
+    // Cut-offs calibrated on single CT sample of earlier firmware do not match AC RMS scale and cannot be converted
+    if (eepromRead(eepromAddress[forSystem] + 13) != motorLoadScaleVersion) {
+        noLoadCutOff = CLEAR;
+        fullLoadCutOff = CLEAR;
+        saveMotorLoadValuesIntoEeprom();
+        motorLoadCalibrationRequired = true;
+    }
     //setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
 }
 
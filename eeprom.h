@@ -22,7 +22,11 @@ void saveFertigationValveStatusIntoEeprom(unsigned int, struct FIELDVALVE *); //
 void saveFertigationValveValuesIntoEeprom(unsigned int, struct FIELDVALVE *); // To save all varibales of field valves EEPROM
 void saveIrrigationValveConfigurationStatusIntoEeprom(unsigned int, struct FIELDVALVE *); // To save field valve Hold status into EEPROM
 void saveIrrigationValvePriorityIntoEeprom(unsigned int, struct FIELDVALVE *); // To save field valve priority into EEPROM
+void commitIrrigationValveConfigurationIntoEeprom(unsigned int, struct FIELDVALVE *); // To save entire field valve configuration into EEPROM in one batch
 void readValveDataFromEeprom(unsigned int, struct FIELDVALVE *); // To read field valve values in to EEPROM
+_Bool assignInjectorProgram(struct FIELDVALVE *, const struct INJECTORPROGRAM *); // To link injector program from pool to field valve
+const struct INJECTORPROGRAM *getInjectorProgram(struct FIELDVALVE *); // To get injector program of field valve
+void loadInjectorProgram(struct FIELDVALVE *); // To load injector program of field valve for injector timer
 //unsigned char readFieldIrrigationValveNoFromEeprom(void); // To read last saved field valve no. 
 void loadDataFromEeprom(void); // To read all data from EEPROM
 void loadDataIntoEeprom(void); // To save all data into EEPROM
@@ -12,6 +12,8 @@
 #include "variableDefinitions.h"
 #include "controllerActions.h"
 #include "gsm.h"
+#include "RTC_DS1307.h"
+#include "numberFormat.h"
 #ifdef DEBUG_MODE_ON_H
 #include "serialMonitor.h"
 #endif					  
@@ -39,6 +41,14 @@ The purpose of this function is to transmit Data loaded into Transmit buffer (TX
  **************************************************************************************************************************/
 // Transmit data through TX pin
 void txByte(unsigned char serialData) {
+#ifdef GSM_FLOW_CONTROL_ON_H
+    unsigned int waitTime = CLEAR;
+    // Wait until GSM is ready to receive, byte is sent anyway after timeout and command to GSM times out if it is lost
+    while (gsmCTS == HIGH && waitTime < gsmCtsTimeout) {
+        myMsDelay(1);
+        waitTime++;
+    }
+#endif
     TX3REG = serialData; // Load Transmit Register 
     while (PIR4bits.TX3IF == CLEAR); // Wait until TXIF gets low
     // ADD indication if infinite
@@ -51,10 +61,15 @@ The purpose of this function is to call transmit Byte data (txByte) Method until
 
  **************************************************************************************************************************/
 void transmitStringToGSM(const char *string) {
+#ifdef GSM_FLOW_CONTROL_ON_H
+    gsmRTS = LOW; // Resume GSM as controller is ready for response of next command
+#endif
     // Until it reaches null
     while (*string) {
         txByte(*string++); // Transmit Byte Data
-        myMsDelay(5);  // Delay reduced to 5 from 50
+        if (!gsmHighBaudRate) {
+            myMsDelay(5);  // Delay reduced to 5 from 50
+        }
     }
 }
 
@@ -69,13 +84,98 @@ void transmitNumberToGSM(unsigned char *number, unsigned char index) {
     // Until it reaches index no.
     while (j < index) {
         txByte(*number++); // Transmit Byte Data
-        myMsDelay(5); // Delay reduced to 5 from 50
+        if (!gsmHighBaudRate) {
+            myMsDelay(5); // Delay reduced to 5 from 50
+        }
         j++;
     }
 }
 
 /*************************************************************************************************************************
 
+This function is called to change baud rate of UART connected to GSM.
+The purpose of this function is to reload baud rate generator after last byte is transmitted.
+
+ **************************************************************************************************************************/
+void setGsmBaudRate(unsigned int baudRateRegister) {
+    while (!TX3STAbits.TRMT); // Wait until last byte is shifted out
+    RC3STAbits.CREN = 0; // Hold reception while baud rate is changed
+    SP3BRGH = (unsigned char)(baudRateRegister >> 8);
+    SP3BRGL = (unsigned char)(baudRateRegister & 0xFF);
+    RC3STAbits.CREN = 1;
+}
+
+/*************************************************************************************************************************
+
+This function is called to check if GSM responds to AT command at current baud rate.
+The purpose of this function is to repeat AT command until GSM responds OK within 5 sec.
+Repeated AT command also lets GSM detect baud rate when it is in auto baud mode.
+
+ **************************************************************************************************************************/
+_Bool isGsmResponding(void) {
+    timer3Count = 5; // 5 sec window
+    controllerCommandExecuted = false;
+    msgIndex = 1;
+    T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 5 sec
+    while (!controllerCommandExecuted) {
+        transmitStringToGSM("AT\r\n");
+        myMsDelay(500);
+    }
+    PIR5bits.TMR3IF = SET; //Stop timer thread
+    return (msgIndex == CLEAR); // Index is reset only on OK response, not on timeout
+}
+
+/*************************************************************************************************************************
+
+This function is called to negotiate baud rate of GSM link at startup.
+The purpose of this function is to move GSM link to 115200 baud.
+GSM is probed at 115200 baud first, as it keeps this rate when only controller is reset.
+Otherwise GSM found at 9600 baud is set to fixed 115200 baud saved in its profile with AT+IPR and AT&W.
+If GSM does not respond at 115200 baud, link is synchronised back at 9600 baud.
+
+ **************************************************************************************************************************/
+void negotiateGsmBaudRate(void) {
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("negotiateGsmBaudRate_IN\r\n");
+    //********Debug log#end**************//
+#endif
+    setBCDdigit(0x0A,1); // (c) BCD indication for negotiateGsmBaudRate
+    gsmHighBaudRate = true;
+    setGsmBaudRate(gsmBaudRate115200);
+    if (!isGsmResponding()) {
+        gsmHighBaudRate = false;
+        setGsmBaudRate(gsmBaudRate9600);
+        if (isGsmResponding()) {
+            timer3Count = 5; // 5 sec window
+            controllerCommandExecuted = false;
+            msgIndex = 1;
+            transmitStringToGSM("AT+IPR=115200;&W\r\n"); // Fixed baud rate saved in user profile, OK is sent at 9600 baud
+            T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 5 sec
+            while (!controllerCommandExecuted);
+            PIR5bits.TMR3IF = SET; //Stop timer thread
+            if (msgIndex == CLEAR) {
+                setGsmBaudRate(gsmBaudRate115200);
+                gsmHighBaudRate = true;
+                if (!isGsmResponding()) {
+                    // Fall back to 9600 baud
+                    gsmHighBaudRate = false;
+                    setGsmBaudRate(gsmBaudRate9600);
+                    isGsmResponding();
+                }
+            }
+        }
+    }
+    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("negotiateGsmBaudRate_OUT\r\n");
+    //********Debug log#end**************//
+#endif
+}
+
+/*************************************************************************************************************************
+
 This function is called to enable receive mode of GSM module.
 The purpose of this function is to transmit AT commands which enables Receive mode of GSM module in Text mode
 
@@ -100,7 +200,11 @@ void configureGSM(void) {
     msgIndex = 1;
     T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 15 sec
     while (!controllerCommandExecuted) {
+    #ifdef BINARY_SMS_ON_H
+        transmitStringToGSM("AT+CMGF=0\r\n"); // PDU Mode command, SMS are read and sent in PDU mode only
+    #else
         transmitStringToGSM("AT+CMGF=1\r\n"); // Text Mode command
+    #endif
         myMsDelay(500);
     }
     PIR5bits.TMR3IF = SET;
@@ -108,10 +212,24 @@ void configureGSM(void) {
     msgIndex = 1;
     T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 15 sec
     while (!controllerCommandExecuted) {
+    #ifdef SMS_DELIVERY_REPORT_ON_H
+        transmitStringToGSM("AT+CNMI=1,1,0,1,0\r\n"); // enable new sms message indication and +CDS delivery report
+    #else
         transmitStringToGSM("AT+CNMI=1,1,0,0,0\r\n"); // enable new sms message indication
+    #endif
         myMsDelay(500);
     }
     PIR5bits.TMR3IF = SET;
+#ifdef SMS_DELIVERY_REPORT_ON_H
+    controllerCommandExecuted = false;
+    msgIndex = 1;
+    T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 15 sec
+    while (!controllerCommandExecuted) {
+        transmitStringToGSM("AT+CSMP=49,167,0,0\r\n"); // Request status report for each sent SMS
+        myMsDelay(500);
+    }
+    PIR5bits.TMR3IF = SET;
+#endif
     controllerCommandExecuted = false;
     msgIndex = 1;
     T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 15 sec
@@ -128,6 +246,16 @@ void configureGSM(void) {
         myMsDelay(500);
     }
     PIR5bits.TMR3IF = SET;
+#ifdef GSM_FLOW_CONTROL_ON_H
+    controllerCommandExecuted = false;
+    msgIndex = 1;
+    T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 15 sec
+    while (!controllerCommandExecuted) {
+        transmitStringToGSM("AT+IFC=2,2\r\n"); // RTS/CTS hardware flow control
+        myMsDelay(500);
+    }
+    PIR5bits.TMR3IF = SET;
+#endif
     setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
@@ -177,11 +305,12 @@ void setGsmToLocalTime(void) {
     gsmSetToLocalTime = false;
     controllerCommandExecuted = false;
     msgIndex = CLEAR;
+    gsmResponseBuffer.length = CLEAR; // Length is set in RX interrupt when response is completed with OK
     transmitStringToGSM("AT+CLTS?\r\n"); // To get local time stamp  +CCLK: "18/05/26,12:00:06+22"
     T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 15 sec
     while (!controllerCommandExecuted);
     PIR5bits.TMR3IF = SET; //Stop timer thread
-    if (gsmResponse[7] != '1') {
+    if (gsmResponseBuffer.length <= 7 || gsmResponse[7] != '1') {
         controllerCommandExecuted = false;
         msgIndex = CLEAR;
         transmitStringToGSM("AT+CLTS=1\r\n"); // To get local time stamp  +CCLK: "18/05/26,12:00:06+22"
@@ -202,11 +331,12 @@ void setGsmToLocalTime(void) {
         myMsDelay(60000);//reboot wait time
         controllerCommandExecuted = false;
         msgIndex = CLEAR;
+        gsmResponseBuffer.length = CLEAR; // Length is set in RX interrupt when response is completed with OK
         transmitStringToGSM("AT+CLTS?\r\n"); // To get local time stamp  +CCLK: "18/05/26,12:00:06+22"
         T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 15 sec
         while (!controllerCommandExecuted);
         PIR5bits.TMR3IF = SET; //Stop timer thread
-        if (gsmResponse[7] == '1') {
+        if (gsmResponseBuffer.length > 7 && gsmResponse[7] == '1') {
             gsmSetToLocalTime = true;
         }
     }
@@ -256,333 +386,976 @@ void deleteMsgFromSIMStorage(void) {
 
 /*************************************************************************************************************************
 
-This function is called to send sms to given mobile no.
-The purpose of this function is to Notify sender regarding its Action in SMS format
+This function is called to append array of bytes to SMS reply being composed
+The purpose of this function is to copy mentioned no. of bytes into reply buffer until SMS text limit is reached.
 
  **************************************************************************************************************************/
-void sendSms(const char *message, unsigned char phoneNumber[], unsigned char info) {
+_Bool appendNumberToReply(const unsigned char *number, unsigned char index) {
+    _Bool replyFits = true;
+    unsigned char j = CLEAR;
+    // Until it reaches index no.
+    while (j < index) {
+        // Keep only bytes of reply window, bytes before window belong to previous part of concatenated SMS
+        if (smsReplyPosition >= smsReplyWindowStart) {
+            if (smsReplyBuffer.length < smsReplyBuffer.capacity) {
+                smsReplyBuffer.data[smsReplyBuffer.length++] = *number;
+            }
+            else {
+                replyFits = false; // Reply exceeds SMS text limit, keep counting its length
+            }
+        }
+        smsReplyPosition++;
+        number++;
+        j++;
+    }
+    return replyFits;
+}
+
+/*************************************************************************************************************************
+
+This function is called to append list of field no. to SMS reply being composed
+The purpose of this function is to append field no. of each field in list which is not present in exclude list.
+
+ **************************************************************************************************************************/
+_Bool appendFieldListToReply(unsigned char *list, unsigned char *excludeList) {
+    _Bool replyFits = true;
     _Bool valveMatched = false;
-    unsigned char index = CLEAR;
-#ifdef DEBUG_MODE_ON_H
-    //********Debug log#start************//
-    transmitStringToDebug("sendSms_IN\r\n");
-    //********Debug log#end**************//
-#endif
-    timer3Count = 30; // 30 sec window
-    //myMsDelay(100);
-    transmitStringToGSM("AT+CMGS=\""); // Command to send an SMS message to GSM mobile
-    myMsDelay(50);
-    transmitNumberToGSM(phoneNumber, 10); // mention user mobile no. to send message
-    myMsDelay(50);
-    transmitStringToGSM("\"\r\n"); // next line to start sms content 
-    myMsDelay(100);
-    transmitStringToGSM(message);
-    /*Encode message in base64 format*/
-    /*
-    strcpy((char *)stringToEncode,message);
-    base64Encoder();
-    transmitStringToGSM((const char *)encodedString); // send encoded message
-    */
-    myMsDelay(100);
-    switch (info) {
-    case newAdmin: //Send Additional info like New Admin Mobile Number  
-        /*
-        strncpy(stringToEncode,temporaryBytesArray,10);
-        base64Encoder();
-        transmitNumberToGSM(encodedString,16); // send encoded info(mobile no.) of new Admin to old Admin 
-        */
-        transmitNumberToGSM(temporaryBytesArray,10);
-        myMsDelay(100);
-        break;
-    case fieldNoRequired: //Send Additional info like field valve number. // do if field valve action is requested
-        /*
-        strncpy(stringToEncode,temporaryBytesArray,2);
-        base64Encoder();
-        transmitNumberToGSM(encodedString,4); // send encoded field no. of valve being requested 
-        */
-        transmitNumberToGSM(temporaryBytesArray,2);
-        myMsDelay(100);
-        break;
-    case timeRequired:
-        /*
-        strncpy(stringToEncode,temporaryBytesArray,17);
-        base64Encoder();
-        transmitNumberToGSM(encodedString,24); // send encoded date time stamp 
-        */
-        transmitNumberToGSM(temporaryBytesArray,17);
-        myMsDelay(100);
-        break;
-    case secretCodeRequired:
-        /*
-        strncpy(stringToEncode,factryPswrd,6);
-        base64Encoder();
-        transmitNumberToGSM(encodedString,24); // send encoded factory password 
-        */
-        transmitNumberToGSM(factryPswrd,6);
-        myMsDelay(100);
-        break;						 
-    case motorLoadRequired:
-        lower8bits = noLoadCutOff;
-        temporaryBytesArray[14] = (unsigned char) ((lower8bits / 1000) + 48);
-        temporaryBytesArray[15] = (unsigned char) (((lower8bits % 1000) / 100) + 48);
-        temporaryBytesArray[16] = (unsigned char) (((lower8bits % 100) / 10) + 48);
-        temporaryBytesArray[17] = (unsigned char) ((lower8bits % 10) + 48);
-        transmitNumberToGSM(temporaryBytesArray+14,4);
-        myMsDelay(50);
-        transmitStringToGSM(" and ");
-        myMsDelay(50);
-        lower8bits = fullLoadCutOff;
-        temporaryBytesArray[14] = (unsigned char) ((lower8bits / 1000) + 48);
-        temporaryBytesArray[15] = (unsigned char) (((lower8bits % 1000) / 100) + 48);
-        temporaryBytesArray[16] = (unsigned char) (((lower8bits % 100) / 10) + 48);
-        temporaryBytesArray[17] = (unsigned char) ((lower8bits % 10) + 48);
-        transmitNumberToGSM(temporaryBytesArray+14,4);
-        myMsDelay(100);
-        break;
-    case frequencyRequired:
-        transmitNumberToGSM(temporaryBytesArray,2);
-        myMsDelay(50);
-        transmitStringToGSM(" is ");
-        myMsDelay(50);
-        lower8bits = moistureLevel;
-        temporaryBytesArray[14] = (unsigned char) ((lower8bits / 10000) + 48);
-        temporaryBytesArray[15] = (unsigned char) (((lower8bits % 10000) / 1000) + 48);
-        temporaryBytesArray[16] = (unsigned char) (((lower8bits % 1000) / 100) + 48);
-        temporaryBytesArray[17] = (unsigned char) (((lower8bits % 100) / 10) + 48);
-        temporaryBytesArray[18] = (unsigned char) ((lower8bits % 10) + 48);
-        transmitNumberToGSM(temporaryBytesArray+14,5);
-        myMsDelay(100);
-        break;
-    case IrrigationData:
-        transmitNumberToGSM(temporaryBytesArray, 2);
-        myMsDelay(10);
-        transmitStringToGSM(" ONprd:");
-        myMsDelay(10);
-        lower8bits = fieldValve[iterator].onPeriod;
-        temporaryBytesArray[0] = (unsigned char) ((lower8bits / 100) + 48);
-        temporaryBytesArray[1] = (unsigned char) (((lower8bits % 100) / 10) + 48);
-        temporaryBytesArray[2] = (unsigned char) ((lower8bits % 10) + 48);
-        transmitNumberToGSM(temporaryBytesArray,3);
-        myMsDelay(10);
-        transmitStringToGSM(" OFFprd:");
-        myMsDelay(10);
-        temporaryBytesArray[0] = (fieldValve[iterator].offPeriod/10) + 48;
-        temporaryBytesArray[1] = (fieldValve[iterator].offPeriod%10) + 48;
-        transmitNumberToGSM(temporaryBytesArray,2);
-        myMsDelay(10);
-        transmitStringToGSM(" Dry:");
-        myMsDelay(10);
-        lower8bits = fieldValve[iterator].dryValue;
-        temporaryBytesArray[0] = (unsigned char) ((lower8bits / 100) + 48);
-        temporaryBytesArray[1] = (unsigned char) (((lower8bits % 100) / 10) + 48);
-        temporaryBytesArray[2] = (unsigned char) ((lower8bits % 10) + 48);
-        transmitNumberToGSM(temporaryBytesArray,3);
-        myMsDelay(10);
-        transmitStringToGSM(" Wet:");
-        myMsDelay(10);
-        lower8bits = fieldValve[iterator].wetValue;
-        temporaryBytesArray[0] = (unsigned char) ((lower8bits / 100) + 48);
-        temporaryBytesArray[1] = (unsigned char) (((lower8bits % 100) / 10) + 48);
-        temporaryBytesArray[2] = (unsigned char) ((lower8bits % 10) + 48);
-        transmitNumberToGSM(temporaryBytesArray,3);
-        myMsDelay(10);
-        transmitStringToGSM(" DueDate: ");
-        myMsDelay(10);
-        temporaryBytesArray[0] = (fieldValve[iterator].nextDueDD/10) + 48;
-        temporaryBytesArray[1] = (fieldValve[iterator].nextDueDD%10) + 48;
-        transmitNumberToGSM(temporaryBytesArray,2);
-        myMsDelay(10);
-        temporaryBytesArray[0] = (fieldValve[iterator].nextDueMM/10) + 48;
-        temporaryBytesArray[1] = (fieldValve[iterator].nextDueMM%10) + 48;
-        transmitNumberToGSM(temporaryBytesArray,2);
-        myMsDelay(10);
-        temporaryBytesArray[0] = (fieldValve[iterator].nextDueYY/10) + 48;
-        temporaryBytesArray[1] = (fieldValve[iterator].nextDueYY%10) + 48;
-        transmitNumberToGSM(temporaryBytesArray,2);
-        myMsDelay(10);
-        temporaryBytesArray[0] = (fieldValve[iterator].motorOnTimeHour/10) + 48;
-        temporaryBytesArray[1] = (fieldValve[iterator].motorOnTimeHour%10) + 48;
-        transmitNumberToGSM(temporaryBytesArray,2);
-        myMsDelay(10);
-        temporaryBytesArray[0] = (fieldValve[iterator].motorOnTimeMinute/10) + 48;
-        temporaryBytesArray[1] = (fieldValve[iterator].motorOnTimeMinute%10) + 48;
-        transmitNumberToGSM(temporaryBytesArray,2);
-        myMsDelay(10);
-        transmitStringToGSM("\r\n");
-        if (fieldValve[iterator].isFertigationEnabled) {
-            transmitStringToGSM("Fertigation enabled with delay:");
-            lower8bits = fieldValve[iterator].fertigationDelay;
-            temporaryBytesArray[0] = (unsigned char) ((lower8bits / 100) + 48);
-            temporaryBytesArray[1] = (unsigned char) (((lower8bits % 100) / 10) + 48);
-            temporaryBytesArray[2] = (unsigned char) ((lower8bits % 10) + 48);
-            transmitNumberToGSM(temporaryBytesArray,3);
-            myMsDelay(10);
-            transmitStringToGSM(" ONprd:");
-            myMsDelay(10);
-            lower8bits = fieldValve[iterator].fertigationONperiod;
-            temporaryBytesArray[0] = (unsigned char) ((lower8bits / 100) + 48);
-            temporaryBytesArray[1] = (unsigned char) (((lower8bits % 100) / 10) + 48);
-            temporaryBytesArray[2] = (unsigned char) ((lower8bits % 10) + 48);
-            transmitNumberToGSM(temporaryBytesArray,3);
-            myMsDelay(10);
-            transmitStringToGSM(" Iteration:");
-            myMsDelay(10);
-            temporaryBytesArray[0] = (fieldValve[iterator].fertigationInstance/10) + 48;
-            temporaryBytesArray[1] = (fieldValve[iterator].fertigationInstance%10) + 48;
-            transmitNumberToGSM(temporaryBytesArray,2);
-            myMsDelay(10);
-            transmitStringToGSM("\r\n");
-        } 
-        else {
-            transmitStringToGSM("Fertigation not configured\r\n");
-            myMsDelay(10);
-        }
-        break;
-    case filtrationData:
-        myMsDelay(10);
-        transmitStringToGSM("\r\nDelay1: ");
-        myMsDelay(10);
-        temporaryBytesArray[0] = (filtrationDelay1/10) + 48;
-        temporaryBytesArray[1] = (filtrationDelay1%10) + 48;
-        transmitNumberToGSM(temporaryBytesArray,2);
-        myMsDelay(10);
-        transmitStringToGSM("(Min) ");
-        myMsDelay(10);
-        transmitStringToGSM("Delay2: ");
-        myMsDelay(10);
-        temporaryBytesArray[0] = (filtrationDelay2/10) + 48;
-        temporaryBytesArray[1] = (filtrationDelay2%10) + 48;
-        transmitNumberToGSM(temporaryBytesArray,2);
-        myMsDelay(10);
-        transmitStringToGSM("(Min) ");
-        myMsDelay(10);
-        transmitStringToGSM("Delay3: ");
-        myMsDelay(10);
-        temporaryBytesArray[0] = (filtrationDelay3/10) + 48;
-        temporaryBytesArray[1] = (filtrationDelay3%10) + 48;
-        transmitNumberToGSM(temporaryBytesArray,2);
-        myMsDelay(10);
-        transmitStringToGSM("(Min)");
-        myMsDelay(10);
-        transmitStringToGSM("\r\nONTime: ");
-        myMsDelay(10);
-        temporaryBytesArray[0] = (filtrationOnTime/10) + 48;
-        temporaryBytesArray[1] = (filtrationOnTime%10) + 48;
-        transmitNumberToGSM(temporaryBytesArray,2);
-        myMsDelay(10);
-        transmitStringToGSM("(Min) ");
-        myMsDelay(10);
-        transmitStringToGSM("Separation Time: ");
-        myMsDelay(10);
-        lower8bits = filtrationSeperationTime;
-        temporaryBytesArray[0] = (unsigned char) ((lower8bits / 100) + 48);
-        temporaryBytesArray[1] = (unsigned char) (((lower8bits % 100) / 10) + 48);
-        temporaryBytesArray[2] = (unsigned char) ((lower8bits % 10) + 48);
-        transmitNumberToGSM(temporaryBytesArray,3);
-        myMsDelay(10);
-        transmitStringToGSM("(Min)");
-        myMsDelay(10);
-        break;
-    case commonActiveFieldNoRequired: //Send Additional info like list of field valve numbers in Parallel action. // do if field valve action is requested       
-        iterator = 0;
-        while(fieldList[iterator] != 255 && iterator < fieldCount) {
-            for (index = 0; lastFieldList[index] != 255; index++) {
-                if (fieldList[iterator]==lastFieldList[index]) {
-                    valveMatched = true; 
-                    break; // skip sms for activating already active valve
+    unsigned char listIndex = CLEAR, index = CLEAR;
+    unsigned char fieldNo[3];
+    while (listIndex < fieldCount && list[listIndex] != 255) {
+        if (excludeList) {
+            for (index = 0; excludeList[index] != 255; index++) {
+                if (list[listIndex] == excludeList[index]) {
+                    valveMatched = true;
+                    break; // skip field whose valve action is already notified
                 }
             }
-            if (valveMatched == false) {
-                /***************************/
-                // for field no. 01 to 09
-                if (fieldList[iterator]<9){
-                    temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                    temporaryBytesArray[1] = fieldList[iterator] + 49; // To store field no. of valve in action 
-                }// for field no. 10 to 12
-                else if (fieldList[iterator] > 8 && fieldList[iterator] < 12) {
-                    temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                    temporaryBytesArray[1] = fieldList[iterator] + 39; // To store field no. of valve in action 
-                }
-                /***************************/
-                //txByte(':');
-                transmitNumberToGSM(temporaryBytesArray,2);
-                txByte(' ');
-                myMsDelay(100);
+        }
+        if (valveMatched == false) {
+            formatFieldNo(list[listIndex], fieldNo); // To store field no. of valve in action
+            fieldNo[2] = ' ';
+            replyFits &= appendNumberToReply(fieldNo, 3);
+        }
+        valveMatched = false;
+        listIndex++;
+    }
+    return replyFits;
+}
+
+/*************************************************************************************************************************
+
+This function is called to append status of all configured valves to SMS reply being composed
+The purpose of this function is to pack configured field mask and status record of each configured valve into bits
+and to append them as base64 characters (6 bits per character) or as raw bytes of binary frame (8 bits per character)
+so that status of all valves fits in one SMS. Values wider than their field are saturated to all ones.
+
+ **************************************************************************************************************************/
+_Bool appendValveStatusToReply(unsigned char characterBits) {
+    const char *base64Set = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    // Width of configured field mask followed by width of each value of record, reserved bit is sent with motor on minute
+    const unsigned char width[11] = {12, 4, 1, 1, 4, 10, 7, 5, 4, 5, 7};
+    unsigned int value[11];
+    _Bool replyFits = true;
+    unsigned long bits = CLEAR; // Bits pending to be sent as base64 characters
+    unsigned char bitCount = CLEAR;
+    unsigned char first = 0, last = 1; // Range of values to be packed, configured field mask is packed first
+    unsigned char field_No;
+    unsigned char index;
+    unsigned char character;
+    value[0] = CLEAR;
+    for (field_No = 0; field_No < fieldCount; field_No++) {
+        if (fieldValve[field_No].isConfigured) {
+            value[0] |= (unsigned int)(0x800 >> field_No);
+        }
+    }
+    field_No = 0;
+    while (1) {
+        for (index = first; index < last; index++) {
+            if (value[index] >= (1U << width[index])) {
+                value[index] = (1U << width[index]) - 1; // Saturate value to its field width
             }
-            valveMatched = false;
-            iterator++;
-        }
-        break;
-    case commonInActiveFieldNoRequired: //Send Additional info like list of field valve numbers in Parallel action. // do if field valve action is requested       
-        iterator = 0;
-        while(lastFieldList[iterator] != 255 && iterator < fieldCount) {
-            for (index = 0; fieldList[index] != 255; index++) {
-                if (lastFieldList[iterator]==fieldList[index]) {
-                    valveMatched = true; 
-                    break; // skip sms for deactivating reactivated valve
+            bits = (bits << width[index]) | value[index];
+            bitCount += width[index];
+            while (bitCount >= characterBits) {
+                bitCount -= characterBits;
+                character = (unsigned char)(bits >> bitCount);
+                if (characterBits == 6) {
+                    character = (unsigned char)base64Set[character & 0x3F];
                 }
+                replyFits &= appendNumberToReply(&character, 1);
             }
-            if (valveMatched == false) {
-                /***************************/
-                // for field no. 01 to 09
-                if (lastFieldList[iterator]<9){
-                    temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                    temporaryBytesArray[1] = lastFieldList[iterator] + 49; // To store field no. of valve in action 
-                }// for field no. 10 to 12
-                else if (lastFieldList[iterator] > 8 && lastFieldList[iterator] < 12) {
-                    temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                    temporaryBytesArray[1] = lastFieldList[iterator] + 39; // To store field no. of valve in action 
+        }
+        // Load record of next configured field
+        while (field_No < fieldCount && !fieldValve[field_No].isConfigured) {
+            field_No++;
+        }
+        if (field_No == fieldCount) {
+            break;
+        }
+        value[1] = fieldValve[field_No].priority;
+        value[2] = fieldValve[field_No].status;
+        value[3] = fieldValve[field_No].isFertigationEnabled;
+        value[4] = (fieldValve[field_No].cyclesExecuted < fieldValve[field_No].cycles) ? fieldValve[field_No].cycles - fieldValve[field_No].cyclesExecuted : 0;
+        value[5] = fieldValve[field_No].onPeriod;
+        value[6] = fieldValve[field_No].offPeriod;
+        value[7] = fieldValve[field_No].nextDueDD;
+        value[8] = fieldValve[field_No].nextDueMM;
+        value[9] = fieldValve[field_No].motorOnTimeHour;
+        value[10] = (unsigned int)fieldValve[field_No].motorOnTimeMinute << 1; // Reserved bit is zero
+        field_No++;
+        first = 1;
+        last = 11;
+    }
+    // Send remaining bits padded with zero, only configured field mask of binary frame leaves them
+    if (bitCount > 0) {
+        character = (unsigned char)(bits << (characterBits - bitCount));
+        if (characterBits == 6) {
+            character = (unsigned char)base64Set[character & 0x3F];
+        }
+        replyFits &= appendNumberToReply(&character, 1);
+    }
+    return replyFits;
+}
+
+/*************************************************************************************************************************
+
+This function is called to append configuration snapshot to SMS reply being composed
+The purpose of this function is to split snapshotImage into parts of snapshotPartSize bytes
+and to append each part as base64 text on its own line "RESTORE<part no.><Space><base64>" to be sent back for restore.
+
+ **************************************************************************************************************************/
+_Bool appendSnapshotToReply(void) {
+    const char *base64Set = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    _Bool replyFits = true;
+    unsigned long bits = CLEAR; // Bits pending to be sent as base64 characters
+    unsigned char bitCount = CLEAR;
+    unsigned char character;
+    unsigned char digits[3];
+    unsigned char part = CLEAR;
+    unsigned int index;
+    for (index = 0; index < snapshotLength; index++) {
+        // Start line of next part
+        if (index % snapshotPartSize == 0) {
+            part++;
+            replyFits &= appendNumberToReply(restore, 7);
+            formatTwoDigits(part, digits);
+            digits[2] = space;
+            replyFits &= appendNumberToReply(digits, 3);
+        }
+        bits = (bits << 8) | snapshotImage[index];
+        bitCount += 8;
+        while (bitCount >= 6) {
+            bitCount -= 6;
+            character = (unsigned char)base64Set[(bits >> bitCount) & 0x3F];
+            replyFits &= appendNumberToReply(&character, 1);
+        }
+        // Complete line at end of part, remaining bits are padded with zero
+        if ((index + 1) % snapshotPartSize == 0 || index + 1 == snapshotLength) {
+            if (bitCount > 0) {
+                character = (unsigned char)base64Set[(bits << (6 - bitCount)) & 0x3F];
+                replyFits &= appendNumberToReply(&character, 1);
+                character = '=';
+                replyFits &= appendNumberToReply(&character, 1);
+                if (bitCount == 2) {
+                    replyFits &= appendNumberToReply(&character, 1);
                 }
-                /***************************/
-                //txByte(':');
-                transmitNumberToGSM(temporaryBytesArray,2);
-                txByte(' ');
-                myMsDelay(100);
+                bitCount = CLEAR;
             }
-            valveMatched = false;
-            iterator++;
-        }
-        break;
-    case fieldListRequired: //Send Additional info like list of field valve numbers in Parallel action. // do if field valve action is requested       
-        iterator = 0;
-        while(fieldList[iterator] != 255 && iterator < fieldCount) {
-            /***************************/
-            // for field no. 01 to 09
-            if (fieldList[iterator]<9){
-                temporaryBytesArray[0] = 48; // To store field no. of valve in action 
-                temporaryBytesArray[1] = fieldList[iterator] + 49; // To store field no. of valve in action 
-            }// for field no. 10 to 12
-            else if (fieldList[iterator] > 8 && fieldList[iterator] < 12) {
-                temporaryBytesArray[0] = 49; // To store field no. of valve in action 
-                temporaryBytesArray[1] = fieldList[iterator] + 39; // To store field no. of valve in action 
+            replyFits &= appendNumberToReply((const unsigned char *)"\r\n", 2);
+        }
+    }
+    return replyFits;
+}
+
+/*************************************************************************************************************************
+
+This function is called to append valve actions listed by PLAN to SMS reply being composed
+The purpose of this function is to append one line per valve action with date, start time, ON period and field no. list.
+
+ **************************************************************************************************************************/
+_Bool appendPlanToReply(void) {
+    _Bool replyFits = true;
+    unsigned char digits[15];
+    unsigned char dd, mm;
+    unsigned char index;
+    unsigned char field_No;
+    unsigned int minuteOfDay;
+    if (planEventTotal == 0) {
+        return appendNumberToReply((const unsigned char *)"\r\nNo valve due", 14);
+    }
+    for (index = 0; index < planEventTotal; index++) {
+        getPlanDate(planStartDay + (planEvent[index].startMinute / planMinutesOfDay), &dd, &mm);
+        minuteOfDay = planEvent[index].startMinute % planMinutesOfDay;
+        digits[0] = '\r';
+        digits[1] = '\n';
+        formatTwoDigits(dd, digits + 2);
+        digits[4] = '/';
+        formatTwoDigits(mm, digits + 5);
+        digits[7] = space;
+        formatTwoDigits((unsigned char)(minuteOfDay / 60), digits + 8);
+        digits[10] = ':';
+        formatTwoDigits((unsigned char)(minuteOfDay % 60), digits + 11);
+        digits[13] = space;
+        replyFits &= appendNumberToReply(digits, 14);
+        formatNumber(planEvent[index].duration, digits, 3);
+        replyFits &= appendNumberToReply(digits, 3);
+        if (planEvent[index].fieldMask & planFertigationFlag) {
+            digits[0] = 'F';
+            replyFits &= appendNumberToReply(digits, 1);
+        }
+        for (field_No = 0; field_No < fieldCount; field_No++) {
+            if (planEvent[index].fieldMask & (1U << field_No)) {
+                digits[0] = space;
+                formatFieldNo(field_No, digits + 1);
+                replyFits &= appendNumberToReply(digits, 3);
             }
-            /***************************/
-            //txByte(':');
-            transmitNumberToGSM(temporaryBytesArray,2);
-            txByte(' ');
-            myMsDelay(100);
-			iterator++;		   
-        }
-        break;
-    case secretCode1Required:
-        /*
-        strncpy(stringToEncode,factryPswrd,6);
-        base64Encoder();
-        transmitNumberToGSM(encodedString,24); // send encoded factory password 
-        */
-        transmitNumberToGSM(pwd,6);
-        myMsDelay(100);
-        break;
+        }
+    }
+    return replyFits;
+}
+
+/*************************************************************************************************************************
+
+This function is called to render SMS template into reply being composed
+The purpose of this function is to copy template text and replace each placeholder {x} by controller state bound to key x.
+Each phrase code of template is expanded into its phrase from SMS phrase dictionary.
+Placeholder {G} continues rendering with fertigation data template of valve in diagnosis.
+
+ **************************************************************************************************************************/
+_Bool renderSmsTemplate(const char *template) {
+    _Bool replyFits = true;
+    const char *phrase;
+    unsigned char digits[10];
+    unsigned char key;
+    while (*template) {
+        // Expand phrase code into phrase of dictionary
+        if ((unsigned char)template[0] >= smsPhraseCode && (unsigned char)template[0] < smsPhraseCode + smsPhraseCount) {
+            phrase = smsPhrase[(unsigned char)*template++ - smsPhraseCode];
+            replyFits &= appendNumberToReply((const unsigned char *)phrase, (unsigned char)strlen(phrase));
+            continue;
+        }
+        // Copy text until placeholder
+        if (template[0] != '{' || template[1] == '\0' || template[2] != '}') {
+            digits[0] = (unsigned char)*template++;
+            replyFits &= appendNumberToReply(digits, 1);
+            continue;
+        }
+        key = (unsigned char)template[1];
+        template += 3;
+        switch (key) {
+        case 'n': // field no.
+            replyFits &= appendNumberToReply(temporaryBytesArray, 2);
+            break;
+        case 'a': // new Admin mobile no.
+            replyFits &= appendNumberToReply(temporaryBytesArray, 10);
+            break;
+        case 't': // date time stamp
+            replyFits &= appendNumberToReply(temporaryBytesArray, 17);
+            break;
+        case 's': // factory password
+            replyFits &= appendNumberToReply(factryPswrd, 6);
+            break;
+        case 'p': // current password
+            replyFits &= appendNumberToReply(pwd, 6);
+            break;
+        case 'L': // no load cut-off
+            formatNumber(noLoadCutOff, digits, 4);
+            replyFits &= appendNumberToReply(digits, 4);
+            break;
+        case 'H': // full load cut-off
+            formatNumber(fullLoadCutOff, digits, 4);
+            replyFits &= appendNumberToReply(digits, 4);
+            break;
+        case 'm': // moisture sensor frequency
+            formatNumber(moistureLevel, digits, 5);
+            replyFits &= appendNumberToReply(digits, 5);
+            break;
+        case 'o': // ON period of valve
+            formatNumber(fieldValve[iterator].onPeriod, digits, 3);
+            replyFits &= appendNumberToReply(digits, 3);
+            break;
+        case 'f': // OFF period of valve
+            formatTwoDigits(fieldValve[iterator].offPeriod, digits);
+            replyFits &= appendNumberToReply(digits, 2);
+            break;
+        case 'd': // Dry value of valve
+            formatNumber(fieldValve[iterator].dryValue, digits, 3);
+            replyFits &= appendNumberToReply(digits, 3);
+            break;
+        case 'w': // Wet value of valve
+            formatNumber(fieldValve[iterator].wetValue, digits, 3);
+            replyFits &= appendNumberToReply(digits, 3);
+            break;
+        case 'D': // due date and motor on time of valve
+            formatTwoDigits(fieldValve[iterator].nextDueDD, digits);
+            formatTwoDigits(fieldValve[iterator].nextDueMM, digits+2);
+            formatTwoDigits(fieldValve[iterator].nextDueYY, digits+4);
+            formatTwoDigits(fieldValve[iterator].motorOnTimeHour, digits+6);
+            formatTwoDigits(fieldValve[iterator].motorOnTimeMinute, digits+8);
+            replyFits &= appendNumberToReply(digits, 10);
+            break;
+        case 'G': // continue with fertigation data of valve
+            if (fieldValve[iterator].isFertigationEnabled) {
+                template = SmsFertData1;
+            }
+            else {
+                template = SmsFertData2;
+            }
+            break;
+        case 'e': // fertigation delay of valve
+            formatNumber(fieldValve[iterator].fertigationDelay, digits, 3);
+            replyFits &= appendNumberToReply(digits, 3);
+            break;
+        case 'r': // fertigation ON period of valve
+            formatNumber(fieldValve[iterator].fertigationONperiod, digits, 3);
+            replyFits &= appendNumberToReply(digits, 3);
+            break;
+        case 'i': // fertigation iterations of valve
+            formatTwoDigits(fieldValve[iterator].fertigationInstance, digits);
+            replyFits &= appendNumberToReply(digits, 2);
+            break;
+        case '1': // filtration delay 1
+            formatTwoDigits(filtrationDelay1, digits);
+            replyFits &= appendNumberToReply(digits, 2);
+            break;
+        case '2': // filtration delay 2
+            formatTwoDigits(filtrationDelay2, digits);
+            replyFits &= appendNumberToReply(digits, 2);
+            break;
+        case '3': // filtration delay 3
+            formatTwoDigits(filtrationDelay3, digits);
+            replyFits &= appendNumberToReply(digits, 2);
+            break;
+        case 'O': // filtration ON time
+            formatTwoDigits(filtrationOnTime, digits);
+            replyFits &= appendNumberToReply(digits, 2);
+            break;
+        case 'S': // filtration separation time
+            formatNumber(filtrationSeperationTime, digits, 3);
+            replyFits &= appendNumberToReply(digits, 3);
+            break;
+        case 'F': // field list
+            replyFits &= appendFieldListToReply(fieldList, NULL);
+            break;
+        case 'A': // field list to activate except already active fields
+            replyFits &= appendFieldListToReply(fieldList, lastFieldList);
+            break;
+        case 'I': // field list to deactivate except reactivated fields
+            replyFits &= appendFieldListToReply(lastFieldList, fieldList);
+            break;
+        case 'V': // status of all configured valves
+            replyFits &= appendValveStatusToReply(6);
+            break;
+        case 'C': // configuration snapshot as RESTORE parts
+            replyFits &= appendSnapshotToReply();
+            break;
+        case 'P': // valve actions listed by PLAN
+            replyFits &= appendPlanToReply();
+            break;
+        case 'N': // occurrences of alert in window
+            formatNumber(alertWindow[alertSummaryIndex].summaryOccurrences, digits, 3);
+            replyFits &= appendNumberToReply(digits, 3);
+            break;
+        case 'h': // start time of alert window
+            formatTwoDigits(alertWindow[alertSummaryIndex].summaryHour, digits);
+            digits[2] = ':';
+            formatTwoDigits(alertWindow[alertSummaryIndex].summaryMinutes, digits+3);
+            replyFits &= appendNumberToReply(digits, 5);
+            break;
+        }
+    }
+    return replyFits;
+}
+
+/*************************************************************************************************************************
+
+This function is called to compose SMS reply from message and its additional info
+The purpose of this function is to render message and template of additional info into reply buffer so that it is transmitted to GSM in one go.
+Only reply window starting at smsReplyWindowStart is kept, false is returned if reply does not fit in buffer.
+Full length of reply is left in smsReplyPosition.
+Response buffer is reduced before reply is rendered into its tail, it is restored after reply is sent or queued.
+
+ **************************************************************************************************************************/
+_Bool composeSmsReply(const char *message, unsigned char info) {
+    _Bool replyFits;
+    gsmResponseBuffer.capacity = smsReplyOffset; // Keep received URC clear of reply buffer
+    smsReplyBuffer.length = CLEAR;
+    smsReplyPosition = CLEAR;
+    replyFits = renderSmsTemplate(message);
+    if (info < smsInfoTemplateCount) {
+        replyFits &= renderSmsTemplate(smsInfoTemplate[info]);
+    }
+    return replyFits;
+}
+
+/*************************************************************************************************************************
+
+This function is called to get message reference from response of AT+CMGS command
+The purpose of this function is to extract <mr> of +CMGS: <mr> response, true is returned if SMS is accepted by GSM.
+
+ **************************************************************************************************************************/
+_Bool getSmsReference(unsigned char *reference) {
+    unsigned char index;
+    if (gsmResponseBuffer.length <= 7 || strncmp(gsmResponse, "+CMGS: ", 7) != 0) {
+        return false;
+    }
+    *reference = CLEAR;
+    for (index = 7; index < gsmResponseBuffer.length && isNumber(gsmResponse[index]); index++) {
+        *reference = (unsigned char)((*reference * 10) + (gsmResponse[index] - '0'));
     }
+    return true;
+}
+
+/*************************************************************************************************************************
+
+This function is called to transmit composed SMS reply to given mobile no.
+The purpose of this function is to send AT+CMGS command and transmit whole SMS text at once after '>' prompt from GSM.
+Message reference given by GSM in +CMGS response is stored at reference and true is returned if SMS is accepted by GSM.
+GSM kept in PDU mode for binary SMS is sent reply as single part SMS-SUBMIT PDU.
+
+ **************************************************************************************************************************/
+_Bool transmitSms(unsigned char phoneNumber[], unsigned char *reference) {
+    _Bool smsAccepted = false;
+    _Bool wasInSleepMode = inSleepMode;
+    inSleepMode = false; // Receive prompt and response in operational mode even if called between sleep cycles
+#ifdef BINARY_SMS_ON_H
+    smsAccepted = transmitSmsPart(phoneNumber, 1, 1, reference);
+#else
+    gsmResponseBuffer.capacity = smsReplyOffset; // Keep response of AT+CMGS clear of reply buffer
+    gsmResponseBuffer.length = CLEAR;
+    timer3Count = 30; // 30 sec window
+    smsPromptReceived = false;
     controllerCommandExecuted = false; // System initiated request of sending sms to GSM			
     msgIndex = CLEAR; // clear message storage index
-    txByte(terminateSms); // terminate SMS
-    myMsDelay(100);
+    transmitStringToGSM("AT+CMGS=\""); // Command to send an SMS message to GSM mobile
+    transmitNumberToGSM(phoneNumber, 10); // mention user mobile no. to send message
+    transmitStringToGSM("\"\r\n"); // next line to start sms content 
     setBCDdigit(0x00,0);  // (0.) BCD indication for OUT SMS Error
+    T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 30 sec
+    while (!smsPromptReceived && !controllerCommandExecuted); // wait until gsm prompts for sms text
+    if (smsPromptReceived) {
+        transmitNumberToGSM(smsReplyBuffer.data, smsReplyBuffer.length); // send whole sms text
+        txByte(terminateSms); // terminate SMS
+        while (!controllerCommandExecuted); // wait until gsm responds to send SMS action
+    }
+    else {
+        txByte(escapeSms); // abort SMS if GSM did not prompt for sms text
+    }
+    PIR5bits.TMR3IF = SET; //Stop timer thread
+    gsmResponseBuffer.capacity = gsmResponseSize;
+    smsAccepted = getSmsReference(reference);
+    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
+#endif
+    inSleepMode = wasInSleepMode;
+    return smsAccepted;
+}
+
+/*************************************************************************************************************************
+
+This function is called to switch GSM between text mode and PDU mode of SMS
+The purpose of this function is to transmit AT+CMGF command until GSM responds OK.
+
+ **************************************************************************************************************************/
+void setSmsMode(_Bool pduMode) {
+    timer3Count = 15; // 15 sec window
+    controllerCommandExecuted = false;
+    msgIndex = 1;
     T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 15 sec
-    while (!controllerCommandExecuted); // wait until gsm responds to send SMS action
+    while (!controllerCommandExecuted) {
+        if (pduMode) {
+            transmitStringToGSM("AT+CMGF=0\r\n"); // PDU Mode command
+        }
+        else {
+            transmitStringToGSM("AT+CMGF=1\r\n"); // Text Mode command
+        }
+        myMsDelay(500);
+    }
     PIR5bits.TMR3IF = SET; //Stop timer thread
+}
+
+/*************************************************************************************************************************
+
+This function is called to transmit an octet of SMS PDU to GSM
+The purpose of this function is to transmit octet as two hexadecimal characters.
+
+ **************************************************************************************************************************/
+void transmitOctetToGSM(unsigned char octet) {
+    const char *hexSet = "0123456789ABCDEF";
+    unsigned char hex[2];
+    hex[0] = (unsigned char)hexSet[octet >> 4];
+    hex[1] = (unsigned char)hexSet[octet & 0x0F];
+    transmitNumberToGSM(hex, 2);
+}
+
+/*************************************************************************************************************************
+
+This function is called to convert character of SMS reply to GSM 7 bit default alphabet
+The purpose of this function is to map ASCII characters which differ in GSM alphabet, characters missing in it are sent as '?'.
+
+ **************************************************************************************************************************/
+unsigned char toGsmAlphabet(unsigned char character) {
+    switch (character) {
+    case '@':
+        return 0x00;
+    case '$':
+        return 0x02;
+    case '_':
+        return 0x11;
+    case '[':
+    case ']':
+    case '{':
+    case '}':
+    case '\\':
+    case '^':
+    case '~':
+    case '|':
+    case '`':
+        return '?';
+    default:
+        return (character < 0x80) ? character : '?';
+    }
+}
+
+/*************************************************************************************************************************
+
+This function is called to convert character of received SMS from GSM 7 bit default alphabet
+The purpose of this function is to map GSM characters which differ in ASCII, characters missing in ASCII are taken as '?'.
+
+ **************************************************************************************************************************/
+unsigned char fromGsmAlphabet(unsigned char character) {
+    switch (character) {
+    case 0x00:
+        return '@';
+    case 0x02:
+        return '$';
+    case 0x11:
+        return '_';
+    case '\n':
+    case '\r':
+        return character;
+    case 0x24: // Currency sign
+    case 0x40: // Inverted exclamation mark
+    case 0x5B: // Accented capital letters
+    case 0x5C:
+    case 0x5D:
+    case 0x5E:
+    case 0x60: // Inverted question mark
+        return '?';
+    default:
+        return (character >= 0x20 && character < 0x7B) ? character : '?';
+    }
+}
+
+/*************************************************************************************************************************
+
+This function is called to start SMS-SUBMIT PDU to given mobile no.
+The purpose of this function is to send AT+CMGS command with length of PDU and to transmit PDU up to destination mobile no.
+after '>' prompt from GSM. GSM is to be in PDU mode. True is returned if GSM prompted for PDU.
+
+ **************************************************************************************************************************/
+_Bool beginSmsPdu(unsigned char phoneNumber[], unsigned char firstOctet, unsigned char dataLength) {
+    unsigned char digits[3];
+    unsigned char index;
+    gsmResponseBuffer.capacity = smsReplyOffset; // Keep response of AT+CMGS clear of reply buffer
+    gsmResponseBuffer.length = CLEAR;
+    timer3Count = 30; // 30 sec window
+    smsPromptReceived = false;
+    controllerCommandExecuted = false; // System initiated request of sending sms to GSM
+    msgIndex = CLEAR; // clear message storage index
+    transmitStringToGSM("AT+CMGS="); // Command to send an SMS PDU to GSM mobile
+    formatNumber(smsPduHeaderSize + dataLength, digits, 3);
+    transmitNumberToGSM(digits, 3); // mention length of PDU without service centre
+    transmitStringToGSM("\r\n");
+    setBCDdigit(0x00,0);  // (0.) BCD indication for OUT SMS Error
+    T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 30 sec
+    while (!smsPromptReceived && !controllerCommandExecuted); // wait until gsm prompts for sms PDU
+    if (smsPromptReceived) {
+        transmitOctetToGSM(0x00); // Service centre stored in SIM
+        transmitOctetToGSM(firstOctet);
+        transmitOctetToGSM(0x00); // Message reference assigned by GSM
+        transmitOctetToGSM(10); // Length of mobile no.
+        transmitOctetToGSM(0x81); // Mobile no. in national format as used in text mode
+        for (index = 0; index < 10; index += 2) {
+            transmitOctetToGSM((unsigned char)(((phoneNumber[index + 1] - '0') << 4) | (phoneNumber[index] - '0'))); // Semi octets of mobile no.
+        }
+    }
+    return smsPromptReceived;
+}
+
+/*************************************************************************************************************************
+
+This function is called to complete SMS-SUBMIT PDU started by beginSmsPdu
+The purpose of this function is to terminate or abort SMS and to wait for response of GSM.
+Message reference given by GSM is stored at reference and true is returned if SMS is accepted by GSM.
+
+ **************************************************************************************************************************/
+_Bool endSmsPdu(_Bool prompted, unsigned char *reference) {
+    _Bool smsAccepted;
+    if (prompted) {
+        txByte(terminateSms); // terminate SMS
+        while (!controllerCommandExecuted); // wait until gsm responds to send SMS action
+    }
+    else {
+        txByte(escapeSms); // abort SMS if GSM did not prompt for sms PDU
+    }
+    PIR5bits.TMR3IF = SET; //Stop timer thread
+    gsmResponseBuffer.capacity = gsmResponseSize;
+    smsAccepted = getSmsReference(reference);
+    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
+    return smsAccepted;
+}
+
+/*************************************************************************************************************************
+
+This function is called to transmit composed reply as one part of concatenated SMS to given mobile no.
+The purpose of this function is to send SMS-SUBMIT PDU with concatenation header and reply packed in GSM 7 bit alphabet.
+Reply of only one part is sent without concatenation header.
+GSM is to be in PDU mode. Message reference given by GSM is stored at reference and true is returned if part is accepted by GSM.
+
+ **************************************************************************************************************************/
+_Bool transmitSmsPart(unsigned char phoneNumber[], unsigned char part, unsigned char parts, unsigned char *reference) {
+    _Bool prompted;
+    _Bool concatenated = (parts > 1);
+    unsigned char index;
+    unsigned int bits = CLEAR; // Septets pending to be sent as octets
+    unsigned char bitCount = concatenated ? 1 : 0; // Fill bit aligns first septet after 6 octets of header
+    unsigned char dataLength = (unsigned char)((concatenated ? 6 : 0) + ((smsReplyBuffer.length * 7) + bitCount + 7) / 8); // Header and packed septets
+    prompted = beginSmsPdu(phoneNumber, concatenated ? (smsSubmitFirstOctet | smsUserDataHeaderIndicator) : smsSubmitFirstOctet, dataLength);
+    if (prompted) {
+        transmitOctetToGSM(0x00); // Protocol identifier
+        transmitOctetToGSM(0x00); // GSM 7 bit default alphabet
+        if (concatenated) {
+            transmitOctetToGSM((unsigned char)(7 + smsReplyBuffer.length)); // Length of user data in septets, header takes 7
+            transmitOctetToGSM(0x05); // Length of user data header
+            transmitOctetToGSM(0x00); // Concatenated SMS with 8 bit reference
+            transmitOctetToGSM(0x03);
+            transmitOctetToGSM(smsConcatReference);
+            transmitOctetToGSM(parts);
+            transmitOctetToGSM(part);
+        }
+        else {
+            transmitOctetToGSM(smsReplyBuffer.length); // Length of user data in septets
+        }
+        for (index = 0; index < smsReplyBuffer.length; index++) {
+            bits |= (unsigned int)toGsmAlphabet(smsReplyBuffer.data[index]) << bitCount;
+            bitCount += 7;
+            while (bitCount >= 8) {
+                transmitOctetToGSM((unsigned char)bits);
+                bits >>= 8;
+                bitCount -= 8;
+            }
+        }
+        if (bitCount > 0) {
+            transmitOctetToGSM((unsigned char)bits);
+        }
+    }
+    return endSmsPdu(prompted, reference);
+}
+
+/*************************************************************************************************************************
+
+This function is called to transmit composed binary frame to given mobile no.
+The purpose of this function is to send bytes of reply buffer as 8 bit user data of SMS-SUBMIT PDU.
+GSM is to be in PDU mode. Message reference given by GSM is stored at reference and true is returned if SMS is accepted by GSM.
+
+ **************************************************************************************************************************/
+_Bool transmitBinarySms(unsigned char phoneNumber[], unsigned char *reference) {
+    _Bool prompted;
+    unsigned char index;
+    prompted = beginSmsPdu(phoneNumber, smsSubmitFirstOctet, smsReplyBuffer.length);
+    if (prompted) {
+        transmitOctetToGSM(0x00); // Protocol identifier
+        transmitOctetToGSM(0x04); // 8 bit data
+        transmitOctetToGSM(smsReplyBuffer.length); // Length of user data in octets
+        for (index = 0; index < smsReplyBuffer.length; index++) {
+            transmitOctetToGSM(smsReplyBuffer.data[index]);
+        }
+    }
+    return endSmsPdu(prompted, reference);
+}
+
+/*************************************************************************************************************************
+
+This function is called to send binary frame composed in reply buffer to given mobile no.
+The purpose of this function is to switch GSM to PDU mode for sending 8 bit SMS and back to text mode.
+
+ **************************************************************************************************************************/
+void sendBinarySms(unsigned char phoneNumber[]) {
+    _Bool wasInSleepMode = inSleepMode;
+    unsigned char reference = CLEAR;
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("sendBinarySms_IN\r\n");
+    //********Debug log#end**************//
+#endif
+    inSleepMode = false; // Receive prompt and response in operational mode even if called between sleep cycles
+    transmitBinarySms(phoneNumber, &reference); // GSM is kept in PDU mode for binary SMS
+    inSleepMode = wasInSleepMode;
+    myMsDelay(500);
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("sendBinarySms_OUT\r\n");
+    //********Debug log#end**************//
+#endif
+}
+
+/*************************************************************************************************************************
+
+This function is called to read received SMS at SIM location given in temporaryBytesArray[0]
+The purpose of this function is to read SMS with one AT+CMGR command and to parse it as per SMS mode of GSM.
+Last 10 digits of sender no. are stored in temporaryBytesArray. SMS text is moved in place to start of gsmResponse
+and binary frame of 8 bit SMS is copied into decodedString. SMS from no. without country code is ignored.
+
+ **************************************************************************************************************************/
+unsigned char readReceivedSms(void) {
+    controllerCommandExecuted = false;
+    gsmResponseBuffer.length = CLEAR; // Length is set in RX interrupt when response is completed with OK
+    timer3Count = 30; // 30 sec window
+    T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 30 sec
+    setBCDdigit(0x03,1);  // (3) BCD indication for Read Sms Action
+    while (!controllerCommandExecuted) {
+        msgIndex = CLEAR;
+    #ifdef BINARY_SMS_ON_H
+        smsPduDataStarted = false;
+        smsPduNibblePending = false;
+        smsPduReception = true;
+    #endif
+        transmitStringToGSM("AT+CMGR=");
+        transmitNumberToGSM(temporaryBytesArray, 1);
+        transmitStringToGSM("\r\n"); // reading msg from sim location
+        myMsDelay(500);
+        if (!controllerCommandExecuted) {
+            myMsDelay(5000);
+        }
+    }
     setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
+    PIR5bits.TMR3IF = SET; //Stop timer thread
+#ifdef BINARY_SMS_ON_H
+    smsPduReception = false;
+    smsPduDataStarted = false;
+    return parseSmsPdu();
+#else
+    return parseSmsText();
+#endif
+}
+
+/*************************************************************************************************************************
+
+This function is called to parse +CMGR response of SMS read in text mode
+The purpose of this function is to locate sender no. and SMS text by delimiters of header,
+so that length of status i.e. REC UNREAD or REC READ does not shift them.
+
+ **************************************************************************************************************************/
+unsigned char parseSmsText(void) {
+    unsigned char index;
+    unsigned char textIndex;
+    if (gsmResponseBuffer.length <= 7 || strncmp(gsmResponse, "+CMGR: ", 7) != 0) {
+        return receivedSmsIgnored;
+    }
+    // Sender no. is quoted field next to quoted status
+    for (index = 7; index + 2 < gsmResponseBuffer.length && !(gsmResponse[index] == '"' && gsmResponse[index + 1] == ',' && gsmResponse[index + 2] == '"'); index++);
+    index += 3;
+    // SMS text follows header line
+    for (textIndex = index; textIndex < gsmResponseBuffer.length && gsmResponse[textIndex] != '\n'; textIndex++);
+    textIndex++;
+    if (textIndex >= gsmResponseBuffer.length || index + 13 >= textIndex || strncmp(gsmResponse + index, countryCode, 3) != 0) {
+        return receivedSmsIgnored;
+    }
+    strncpy(temporaryBytesArray, gsmResponse + index + 3, 10); // Save received sender no. as temp user
+    gsmResponseBuffer.length -= textIndex;
+    memmove(gsmResponse, gsmResponse + textIndex, gsmResponseBuffer.length);
+    return receivedSmsText;
+}
+
+/*************************************************************************************************************************
+
+This function is called to parse SMS-DELIVER PDU of SMS read in PDU mode
+The purpose of this function is to decide from data coding if SMS carries binary frame or text.
+8 bit user data is copied into decodedString, GSM 7 bit user data is unpacked in place to start of gsmResponse.
+Part of concatenated SMS is ignored as parts are not reassembled, so that first part of long command is not executed truncated.
+Other user data header is skipped. Hexadecimal PDU is packed into octets by RX interrupt while it is received.
+
+ **************************************************************************************************************************/
+unsigned char parseSmsPdu(void) {
+    unsigned int index;
+    unsigned int element;
+    unsigned int bitIndex;
+    unsigned char firstOctet;
+    unsigned char digitCount;
+    unsigned char senderType;
+    unsigned char dataCoding;
+    unsigned char dataLength;
+    unsigned char headerLength = CLEAR;
+    unsigned char septet;
+    unsigned char character;
+    unsigned char prefixLength = (unsigned char)strlen(countryCode + 1); // Country code without '+'
+    // Skip header line of +CMGR response
+    for (index = 0; index < gsmResponseBuffer.length && gsmResponse[index] != '\n'; index++);
+    index++;
+    if (index + 2 >= gsmResponseBuffer.length) {
+        return receivedSmsIgnored;
+    }
+    index += gsmResponse[index] + 1; // Service centre
+    if (index + 2 >= gsmResponseBuffer.length) {
+        return receivedSmsIgnored;
+    }
+    firstOctet = gsmResponse[index++];
+    digitCount = gsmResponse[index++];
+    senderType = gsmResponse[index++];
+    // Sender no. in international format with country code
+    if ((senderType & 0x70) != 0x10 || digitCount != prefixLength + 10 || index + (digitCount + 1) / 2 + 10 > gsmResponseBuffer.length) {
+        return receivedSmsIgnored;
+    }
+    // Digits are swapped in each octet
+    for (septet = 0; septet < digitCount; septet++) {
+        character = gsmResponse[index + septet / 2];
+        temporaryBytesArray[septet] = (unsigned char)('0' + ((septet & 0x01) ? (character >> 4) : (character & 0x0F)));
+    }
+    if (strncmp(temporaryBytesArray, countryCode + 1, prefixLength) != 0) {
+        return receivedSmsIgnored;
+    }
+    memmove(temporaryBytesArray, temporaryBytesArray + prefixLength, 10); // Keep last 10 digits of sender no.
+    index += (digitCount + 1) / 2;
+    index++; // Protocol identifier
+    dataCoding = gsmResponse[index++];
+    index += 7; // Service centre time stamp
+    dataLength = gsmResponse[index++];
+    if ((firstOctet & smsUserDataHeaderIndicator) && index < gsmResponseBuffer.length) {
+        headerLength = (unsigned char)(gsmResponse[index] + 1);
+        if (index + headerLength > gsmResponseBuffer.length) {
+            return receivedSmsIgnored;
+        }
+        // Check information elements for concatenated SMS with 8 bit or 16 bit reference having more than one part
+        for (element = index + 1; element + 1 < index + headerLength; element += gsmResponse[element + 1] + 2) {
+            if ((gsmResponse[element] == 0x00 && gsmResponse[element + 1] == 3 && element + 4 < index + headerLength && gsmResponse[element + 3] > 1)
+                || (gsmResponse[element] == 0x08 && gsmResponse[element + 1] == 4 && element + 5 < index + headerLength && gsmResponse[element + 4] > 1)) {
+            #ifdef DEBUG_MODE_ON_H
+                //********Debug log#start************//
+                transmitStringToDebug("parseSmsPdu_ConcatenatedIgnored\r\n");
+                //********Debug log#end**************//
+            #endif
+                return receivedSmsIgnored;
+            }
+        }
+    }
+    // 8 bit data coding of general or message class group
+    if (((dataCoding & 0xCC) == 0x04) || ((dataCoding & 0xF4) == 0xF4)) {
+        if (dataLength < headerLength || dataLength - headerLength > binaryFrameSize || index + dataLength > gsmResponseBuffer.length) {
+            return receivedSmsIgnored;
+        }
+        decodedStringBuffer.length = dataLength - headerLength;
+        memcpy(decodedString, gsmResponse + index + headerLength, decodedStringBuffer.length);
+        return receivedSmsBinary;
+    }
+    // GSM 7 bit default alphabet of general or message class group
+    if (((dataCoding & 0xCC) == 0x00) || ((dataCoding & 0xF4) == 0xF0)) {
+        headerLength = (unsigned char)((headerLength * 8 + 6) / 7); // Septets taken by header and its fill bits
+        if (dataLength < headerLength || dataLength > smsTextSize || index + ((unsigned int)dataLength * 7 + 7) / 8 > gsmResponseBuffer.length) {
+            return receivedSmsIgnored;
+        }
+        // Unpacked text is written behind packed septets yet to be read as PDU header is longer than 20 octets
+        for (septet = 0; septet < dataLength; septet++) {
+            bitIndex = (unsigned int)septet * 7;
+            character = (unsigned char)(gsmResponse[index + bitIndex / 8] >> (bitIndex % 8));
+            if (bitIndex % 8 > 1) {
+                character |= (unsigned char)(gsmResponse[index + bitIndex / 8 + 1] << (8 - bitIndex % 8));
+            }
+            if (septet >= headerLength) {
+                gsmResponse[septet - headerLength] = fromGsmAlphabet(character & 0x7F);
+            }
+        }
+        gsmResponseBuffer.length = dataLength - headerLength;
+        return receivedSmsText;
+    }
+    return receivedSmsIgnored; // UCS2 text is not supported
+}
+
+/*************************************************************************************************************************
+
+This function is called to send reply longer than one SMS as concatenated SMS to given mobile no.
+The purpose of this function is to render reply again for each part so that no buffer of whole reply is needed.
+Reply is truncated to smsConcatMaxParts parts.
+
+ **************************************************************************************************************************/
+_Bool transmitConcatenatedSms(const char *message, unsigned char info, unsigned char phoneNumber[], unsigned char *reference) {
+    _Bool smsAccepted = true;
+    _Bool wasInSleepMode = inSleepMode;
+    unsigned char part;
+    unsigned char parts;
+    inSleepMode = false; // Receive prompt and response in operational mode even if called between sleep cycles
+    composeSmsReply(message, info); // Get full length of reply
+    parts = (unsigned char)((smsReplyPosition + smsConcatTextSize - 1) / smsConcatTextSize);
+    if (parts > smsConcatMaxParts) {
+        parts = smsConcatMaxParts;
+    }
+    smsConcatReference++;
+#ifndef BINARY_SMS_ON_H
+    setSmsMode(true);
+#endif
+    smsReplyBuffer.capacity = smsConcatTextSize;
+    for (part = 0; part < parts; part++) {
+        smsReplyWindowStart = (unsigned int)part * smsConcatTextSize;
+        composeSmsReply(message, info);
+        smsAccepted &= transmitSmsPart(phoneNumber, (unsigned char)(part + 1), parts, reference);
+        myMsDelay(500);
+    }
+    smsReplyWindowStart = CLEAR;
+    smsReplyBuffer.capacity = smsTextSize;
+#ifndef BINARY_SMS_ON_H
+    setSmsMode(false);
+#endif
+    inSleepMode = wasInSleepMode;
+    return smsAccepted;
+}
+
+/*************************************************************************************************************************
+
+This function is called to send sms to given mobile no.
+The purpose of this function is to Notify sender regarding its Action in SMS format
+Reply is composed before AT+CMGS command and whole SMS text is transmitted at once after '>' prompt from GSM.
+Reply longer than one SMS is sent as concatenated SMS.
+SMS to user without volatile additional info is tracked for delivery report instead of waiting for it, and sent again on failure.
+
+ **************************************************************************************************************************/
+void sendSms(const char *message, unsigned char phoneNumber[], unsigned char info) {
+    _Bool smsAccepted;
+    unsigned char reference = CLEAR;
+#ifdef SMS_DELIVERY_REPORT_ON_H
+    struct SMSDELIVERY *delivery;
+#endif
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("sendSms_IN\r\n");
+    //********Debug log#end**************//
+#endif
+    if (composeSmsReply(message, info)) {
+        smsAccepted = transmitSms(phoneNumber, &reference);
+    }
+    else {
+    #ifdef DEBUG_MODE_ON_H
+        //********Debug log#start************//
+        transmitStringToDebug("sendSms_Concatenated\r\n"); // Reply exceeds 160 characters
+        //********Debug log#end**************//
+    #endif
+        smsAccepted = transmitConcatenatedSms(message, info, phoneNumber, &reference);
+    }
+#ifdef SMS_DELIVERY_REPORT_ON_H
+    // Track SMS to user, whose reply can be composed again from message and field no.
+    if (phoneNumber == userMobileNo && (info == noInfo || info == fieldNoRequired)) {
+        delivery = &smsDelivery[smsDeliveryNext];
+        smsDeliveryNext = (unsigned char)((smsDeliveryNext + 1) % smsDeliveryCount); // Overwrite oldest SMS in round robin
+        delivery->message = message;
+        delivery->info = info;
+        delivery->fieldNo[0] = temporaryBytesArray[0];
+        delivery->fieldNo[1] = temporaryBytesArray[1];
+        delivery->reference = reference;
+        delivery->status = smsAccepted ? smsDeliveryPending : smsDeliveryFailed;
+        delivery->retries = CLEAR;
+        setSmsDeliverySentTime(delivery);
+    }
+#else
+    (void)smsAccepted;
+#endif
     myMsDelay(500);
 #ifdef DEBUG_MODE_ON_H
     //********Debug log#start************//
@@ -593,6 +1366,258 @@ void sendSms(const char *message, unsigned char phoneNumber[], unsigned char inf
 
 /*************************************************************************************************************************
 
+This function is called to queue notification to user
+The purpose of this function is to render notification into SMS queue so that notifications of one control step are sent in single SMS.
+Priority is smsAcknowledgement or alert type of alarm, repeated alarm of same alert type within window is only counted.
+Alarm is placed ahead of queued acknowledgements, queue is sent first if notification does not fit in it.
+Notification longer than one SMS is sent as concatenated SMS right after queued notifications.
+
+ **************************************************************************************************************************/
+void queueSms(const char *message, unsigned char info, unsigned char priority) {
+    unsigned char length;
+    unsigned char position;
+    if (priority != smsAcknowledgement && isAlertSuppressed(priority)) {
+        return;
+    }
+    if (!composeSmsReply(message, info)) {
+        flushSmsQueue();
+        sendSms(message, userMobileNo, info);
+        return;
+    }
+    length = smsReplyBuffer.length;
+    if (smsQueueBuffer.length + length + smsQueueSeparatorSize > smsQueueBuffer.capacity) {
+        flushSmsQueue();
+        composeSmsReply(message, info); // Reply buffer is overwritten by sent queue
+    }
+    position = (priority != smsAcknowledgement) ? smsQueueAlarmLength : smsQueueBuffer.length;
+    memmove(smsQueueText + position + length + smsQueueSeparatorSize, smsQueueText + position, smsQueueBuffer.length - position);
+    memcpy(smsQueueText + position, smsReplyBuffer.data, length);
+    memcpy(smsQueueText + position + length, smsQueueSeparator, smsQueueSeparatorSize);
+    gsmResponseBuffer.capacity = gsmResponseSize; // Queued reply is not sent from reply buffer
+    smsQueueBuffer.length += length + smsQueueSeparatorSize;
+    if (priority != smsAcknowledgement) {
+        smsQueueAlarmLength += length + smsQueueSeparatorSize;
+    }
+}
+
+/*************************************************************************************************************************
+
+This function is called to get minutes elapsed since given day number and minute of day
+The purpose of this function is to measure age from current date and time, so that event of days ago is taken as old.
+0xFFFF is returned if clock is set back before start or start is more than 45 days ago.
+
+ **************************************************************************************************************************/
+unsigned int getMinutesElapsed(unsigned int startDay, unsigned int startMinute) {
+    long age;
+    age = ((long)getPlanDayNumber(currentDD, currentMM, currentYY) - startDay) * planMinutesOfDay;
+    age += ((long)currentHour * 60 + currentMinutes) - startMinute;
+    if (age < 0 || age > 0xFFFF) {
+        return 0xFFFF;
+    }
+    return (unsigned int)age;
+}
+
+/*************************************************************************************************************************
+
+This function is called to get minutes elapsed since alert window is opened
+The purpose of this function is to measure age of alert window, so that window opened days ago is over.
+
+ **************************************************************************************************************************/
+unsigned int getAlertWindowAge(struct ALERTWINDOW *window) {
+    return getMinutesElapsed(window->startDay, window->startMinute);
+}
+
+/*************************************************************************************************************************
+
+This function is called to check if alarm of given alert type is to be suppressed
+The purpose of this function is to count alarm raised within window of its alert type and to open new window otherwise.
+
+ **************************************************************************************************************************/
+_Bool isAlertSuppressed(unsigned char alert) {
+    struct ALERTWINDOW *window = &alertWindow[alert - 1];
+    getCurrentTime();
+    if (window->occurrences > 0 && getAlertWindowAge(window) < alertWindowMinutes) {
+        if (window->occurrences < 255) {
+            window->occurrences++;
+        }
+        return true;
+    }
+    closeAlertWindow(window); // Keep summary of window being replaced
+    window->startDay = getPlanDayNumber(currentDD, currentMM, currentYY);
+    window->startMinute = (unsigned int)currentHour * 60 + currentMinutes;
+    window->startHour = currentHour;
+    window->startMinutes = currentMinutes;
+    window->occurrences = 1;
+    return false;
+}
+
+/*************************************************************************************************************************
+
+This function is called to close alert window
+The purpose of this function is to keep count and start time of window having repeated alarms until summary is reported.
+Summary is not queued here as it is called from queueSms.
+
+ **************************************************************************************************************************/
+void closeAlertWindow(struct ALERTWINDOW *window) {
+    if (window->occurrences > 1) {
+        if (window->summaryOccurrences == 0) {
+            window->summaryHour = window->startHour;
+            window->summaryMinutes = window->startMinutes;
+        }
+        if (window->summaryOccurrences > 255 - window->occurrences) {
+            window->summaryOccurrences = 255;
+        }
+        else {
+            window->summaryOccurrences += window->occurrences;
+        }
+    }
+    window->occurrences = CLEAR;
+}
+
+/*************************************************************************************************************************
+
+This function is called to close alert windows which are over and to report closed windows
+The purpose of this function is to queue one summary of occurrences for each closed window having repeated alarms.
+
+ **************************************************************************************************************************/
+void reportSuppressedAlerts(void) {
+    getCurrentTime();
+    for (alertSummaryIndex = 0; alertSummaryIndex < alertTypeCount; alertSummaryIndex++) {
+        if (alertWindow[alertSummaryIndex].occurrences != 0 && getAlertWindowAge(&alertWindow[alertSummaryIndex]) >= alertWindowMinutes) {
+            closeAlertWindow(&alertWindow[alertSummaryIndex]);
+        }
+        if (alertWindow[alertSummaryIndex].summaryOccurrences != 0) {
+            queueSms(alertSummaryTemplate[alertSummaryIndex], noInfo, smsAcknowledgement);
+            alertWindow[alertSummaryIndex].summaryOccurrences = CLEAR;
+        }
+    }
+}
+
+/*************************************************************************************************************************
+
+This function is called to send queued notifications to user
+The purpose of this function is to transmit all queued notifications in one SMS and to empty queue.
+
+ **************************************************************************************************************************/
+void flushSmsQueue(void) {
+    unsigned char reference = CLEAR;
+    if (smsQueueBuffer.length == 0) {
+        return;
+    }
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("flushSmsQueue_IN\r\n");
+    //********Debug log#end**************//
+#endif
+    gsmResponseBuffer.capacity = smsReplyOffset; // Keep received URC clear of reply buffer
+    smsReplyBuffer.length = smsQueueBuffer.length - smsQueueSeparatorSize; // Separator of last notification is not sent
+    memcpy(smsReplyBuffer.data, smsQueueText, smsReplyBuffer.length);
+    smsQueueBuffer.length = CLEAR;
+    smsQueueAlarmLength = CLEAR;
+    transmitSms(userMobileNo, &reference);
+    myMsDelay(500);
+#ifdef DEBUG_MODE_ON_H
+    //********Debug log#start************//
+    transmitStringToDebug("flushSmsQueue_OUT\r\n");
+    //********Debug log#end**************//
+#endif
+}
+
+/*************************************************************************************************************************
+
+This function is called to match received +CDS delivery reports with tracked SMS
+The purpose of this function is to update delivery status of SMS having same message reference for each queued report.
+Report of SMS which is not tracked is dropped.
+Status below 0x20 is delivered, 0x20 to 0x3F is still being tried by network and 0x40 onwards is failed.
+SMS without delivery report within smsDeliveryTimeout is expired, so that its reference reused by GSM is not matched.
+
+ **************************************************************************************************************************/
+void checkSmsDeliveryReport(void) {
+    struct DELIVERYREPORT *report;
+    unsigned char index;
+    _Bool timeFetched = false;
+    for (index = 0; index < smsDeliveryCount; index++) {
+        if (smsDelivery[index].status != smsDeliveryPending) {
+            continue;
+        }
+        if (!timeFetched) {
+            getCurrentTime();
+            timeFetched = true;
+        }
+        if (getMinutesElapsed(smsDelivery[index].sentDay, smsDelivery[index].sentMinute) >= smsDeliveryTimeout) {
+            smsDelivery[index].status = smsDeliveryExpired;
+        }
+    }
+    while (deliveryReportTail != deliveryReportHead) {
+        report = &deliveryReportQueue[deliveryReportTail];
+        for (index = 0; index < smsDeliveryCount; index++) {
+            if (smsDelivery[index].status == smsDeliveryPending && smsDelivery[index].reference == report->reference) {
+                if (report->status < 0x20) {
+                    smsDelivery[index].status = smsDeliveryDelivered;
+                }
+                else if (report->status >= 0x40) {
+                    smsDelivery[index].status = smsDeliveryFailed;
+                }
+            #ifdef DEBUG_MODE_ON_H
+                //********Debug log#start************//
+                transmitStringToDebug("checkSmsDeliveryReport_Matched\r\n");
+                //********Debug log#end**************//
+            #endif
+                break;
+            }
+        }
+        deliveryReportTail = (unsigned char)((deliveryReportTail + 1) % deliveryReportQueueSize); // Release slot for next report
+    }
+}
+
+/*************************************************************************************************************************
+
+This function is called to send again SMS which is failed to deliver
+The purpose of this function is to compose tracked SMS again with its field no. and send it to user until retries are over.
+
+ **************************************************************************************************************************/
+void retryUndeliveredSms(void) {
+    unsigned char index;
+    unsigned char reference = CLEAR;
+    for (index = 0; index < smsDeliveryCount; index++) {
+        if (smsDelivery[index].status != smsDeliveryFailed) {
+            continue;
+        }
+        if (smsDelivery[index].retries >= smsDeliveryMaxRetries) {
+            smsDelivery[index].status = smsDeliveryAbandoned;
+            continue;
+        }
+        smsDelivery[index].retries++;
+        temporaryBytesArray[0] = smsDelivery[index].fieldNo[0];
+        temporaryBytesArray[1] = smsDelivery[index].fieldNo[1];
+        composeSmsReply(smsDelivery[index].message, smsDelivery[index].info);
+        if (transmitSms(userMobileNo, &reference)) {
+            smsDelivery[index].reference = reference;
+            smsDelivery[index].status = smsDeliveryPending;
+            setSmsDeliverySentTime(&smsDelivery[index]);
+        }
+    #ifdef DEBUG_MODE_ON_H
+        //********Debug log#start************//
+        transmitStringToDebug("retryUndeliveredSms_Sent\r\n");
+        //********Debug log#end**************//
+    #endif
+    }
+}
+
+/*************************************************************************************************************************
+
+This function is called to note time at which tracked SMS is sent
+The purpose of this function is to start timeout of delivery report from current date and time.
+
+ **************************************************************************************************************************/
+void setSmsDeliverySentTime(struct SMSDELIVERY *delivery) {
+    getCurrentTime();
+    delivery->sentDay = getPlanDayNumber(currentDD, currentMM, currentYY);
+    delivery->sentMinute = (unsigned int)currentHour * 60 + currentMinutes;
+}
+
+/*************************************************************************************************************************
+
 This function is called to reset GSM Module
 The purpose of this function is to reset GSM module on ERROR.
 
@@ -628,11 +1653,12 @@ void checkSignalStrength(void) {
         setBCDdigit(0x0A,1);  // (c) BCD indication for checkSignalStrength Action
         controllerCommandExecuted = false;
         msgIndex = CLEAR;
+        gsmResponseBuffer.length = CLEAR; // Length is set in RX interrupt when response is completed with OK
         transmitStringToGSM("AT+CSQ\r\n"); // To get signal strength
         T3CONbits.TMR3ON = ON; // Start timer thread to unlock system if GSM fails to respond within 15 sec
         while (!controllerCommandExecuted);
         PIR5bits.TMR3IF = SET; //Stop timer thread
-        for(msgIndex = 6;  gsmResponse[msgIndex] != ',' ; msgIndex++)  
+        for(msgIndex = 6; msgIndex < gsmResponseBuffer.length && gsmResponse[msgIndex] != ','; msgIndex++)  
         {
             if(isNumber(gsmResponse[msgIndex])) //is number
             {	
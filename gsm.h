@@ -18,8 +18,43 @@ void transmitStringToGSM(const char*); // To transmit string of bytes to GSM
 void transmitNumberToGSM(unsigned char*, unsigned char); // To transmit array of bytes to GSM
 void setGsmToLocalTime(void); // To set GSM at local time standard across the globe
 void checkGsmConnection(void); // To check GSM connection
+_Bool appendNumberToReply(const unsigned char*, unsigned char); // To append array of bytes to SMS reply
+_Bool appendFieldListToReply(unsigned char*, unsigned char*); // To append list of field no. to SMS reply
+_Bool appendValveStatusToReply(unsigned char); // To append packed status of all configured valves to SMS reply
+_Bool appendSnapshotToReply(void); // To append configuration snapshot as RESTORE parts to SMS reply
+_Bool appendPlanToReply(void); // To append valve actions listed by PLAN to SMS reply
+_Bool renderSmsTemplate(const char*); // To render SMS template into reply
+_Bool composeSmsReply(const char*, unsigned char); // To compose SMS reply in single buffer
+_Bool getSmsReference(unsigned char*); // To get message reference from +CMGS response
+_Bool transmitSms(unsigned char[], unsigned char*); // To transmit composed SMS reply
+void setSmsMode(_Bool); // To switch GSM between text mode and PDU mode of SMS
+void transmitOctetToGSM(unsigned char); // To transmit octet of SMS PDU in hexadecimal
+unsigned char toGsmAlphabet(unsigned char); // To convert character to GSM 7 bit default alphabet
+unsigned char fromGsmAlphabet(unsigned char); // To convert character from GSM 7 bit default alphabet
+_Bool beginSmsPdu(unsigned char[], unsigned char, unsigned char); // To start SMS-SUBMIT PDU
+_Bool endSmsPdu(_Bool, unsigned char*); // To complete SMS-SUBMIT PDU
+_Bool transmitSmsPart(unsigned char[], unsigned char, unsigned char, unsigned char*); // To transmit one part of concatenated SMS
+_Bool transmitConcatenatedSms(const char*, unsigned char, unsigned char[], unsigned char*); // To send long reply as concatenated SMS
+_Bool transmitBinarySms(unsigned char[], unsigned char*); // To transmit binary frame as 8 bit SMS
+void sendBinarySms(unsigned char[]); // To send binary frame composed in reply buffer
+unsigned char readReceivedSms(void); // To read received SMS with single AT+CMGR command
+unsigned char parseSmsText(void); // To locate sender no. and text of SMS read in text mode
+unsigned char parseSmsPdu(void); // To decode sender no. and user data of SMS read in PDU mode
 void sendSms(const char*, unsigned char[], unsigned char); // To send sms 
+void queueSms(const char*, unsigned char, unsigned char); // To queue notification to user
+void flushSmsQueue(void); // To send queued notifications in one SMS
+unsigned int getMinutesElapsed(unsigned int, unsigned int); // To get minutes elapsed since given day number and minute of day
+unsigned int getAlertWindowAge(struct ALERTWINDOW*); // To get minutes elapsed since alert window is opened
+_Bool isAlertSuppressed(unsigned char); // To check if repeated alarm is to be suppressed
+void closeAlertWindow(struct ALERTWINDOW*); // To keep summary of alert window being closed
+void reportSuppressedAlerts(void); // To queue summary of suppressed alarms
+void checkSmsDeliveryReport(void); // To match received delivery report with sent SMS
+void retryUndeliveredSms(void); // To send again SMS failed to deliver
+void setSmsDeliverySentTime(struct SMSDELIVERY*); // To note time at which tracked SMS is sent
 void configureGSM(void); // To enable reception
+void setGsmBaudRate(unsigned int); // To change baud rate of GSM link
+_Bool isGsmResponding(void); // To check GSM responds to AT command
+void negotiateGsmBaudRate(void); // To move GSM link to 115200 baud with fallback to 9600
 void deleteMsgFromSIMStorage(void); // To delete sms from sim memory
 void checkSignalStrength(void); // To check GSM signal strength
 /***************************** Serial communication functions declarations#end ******/
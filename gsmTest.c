@@ -11,6 +11,7 @@
 #include "congfigBits.h"
 #include "variableDefinitions.h"
 #include "controllerActions.h"
+#include "eeprom.h"
 #include "gsm.h"
 #ifdef DEBUG_MODE_ON_H
 #include "serialMonitor.h"
@@ -51,8 +52,18 @@ The purpose of this function is to call transmit Byte data (txByte) Method until
 
  **************************************************************************************************************************/
 void transmitStringToGSM(const char *string) {
+    const char *phrase;
     // Until it reaches null
     while (*string) {
+        // Expand phrase code into phrase of dictionary
+        if ((unsigned char)*string >= smsPhraseCode && (unsigned char)*string < smsPhraseCode + smsPhraseCount) {
+            phrase = smsPhrase[(unsigned char)*string++ - smsPhraseCode];
+            while (*phrase) {
+                txByte(*phrase++); // Transmit Byte Data
+                myMsDelay(5);
+            }
+            continue;
+        }
         txByte(*string++); // Transmit Byte Data
         myMsDelay(5);  // Delay reduced to 5 from 50
     }
@@ -434,46 +445,46 @@ void sendSms(const char *message, unsigned char phoneNumber[], unsigned char inf
                 myMsDelay(10);
                 transmitStringToGSM(" Inj1: ");
                 myMsDelay(10);
-                temporaryBytesArray[0] = (fieldValve[fieldList[iterator]].injector1OnPeriod%10) + 48;
+                temporaryBytesArray[0] = (getInjectorProgram(&fieldValve[fieldList[iterator]])->onPeriod[0]%10) + 48;
                 transmitNumberToGSM(temporaryBytesArray,1);
                 myMsDelay(10);
-                temporaryBytesArray[0] = (fieldValve[fieldList[iterator]].injector1OffPeriod%10) + 48;
+                temporaryBytesArray[0] = (getInjectorProgram(&fieldValve[fieldList[iterator]])->offPeriod[0]%10) + 48;
                 transmitNumberToGSM(temporaryBytesArray,1);
                 myMsDelay(10);
-                temporaryBytesArray[0] = (fieldValve[fieldList[iterator]].injector1Cycle%10) + 48;
+                temporaryBytesArray[0] = (getInjectorProgram(&fieldValve[fieldList[iterator]])->cycle[0]%10) + 48;
                 transmitNumberToGSM(temporaryBytesArray,1);
                 myMsDelay(10);
                 transmitStringToGSM(" Inj2: ");
                 myMsDelay(10);
-                temporaryBytesArray[0] = (fieldValve[fieldList[iterator]].injector2OnPeriod%10) + 48;
+                temporaryBytesArray[0] = (getInjectorProgram(&fieldValve[fieldList[iterator]])->onPeriod[1]%10) + 48;
                 transmitNumberToGSM(temporaryBytesArray,1);
                 myMsDelay(10);
-                temporaryBytesArray[0] = (fieldValve[fieldList[iterator]].injector2OffPeriod%10) + 48;
+                temporaryBytesArray[0] = (getInjectorProgram(&fieldValve[fieldList[iterator]])->offPeriod[1]%10) + 48;
                 transmitNumberToGSM(temporaryBytesArray,1);
                 myMsDelay(10);
-                temporaryBytesArray[0] = (fieldValve[fieldList[iterator]].injector2Cycle%10) + 48;
+                temporaryBytesArray[0] = (getInjectorProgram(&fieldValve[fieldList[iterator]])->cycle[1]%10) + 48;
                 transmitNumberToGSM(temporaryBytesArray,1);
                 myMsDelay(10);
                 transmitStringToGSM(" Inj3: ");
                 myMsDelay(10);
-                temporaryBytesArray[0] = (fieldValve[fieldList[iterator]].injector3OnPeriod%10) + 48;
+                temporaryBytesArray[0] = (getInjectorProgram(&fieldValve[fieldList[iterator]])->onPeriod[2]%10) + 48;
                 transmitNumberToGSM(temporaryBytesArray,1);
                 myMsDelay(10);
-                temporaryBytesArray[0] = (fieldValve[fieldList[iterator]].injector3OffPeriod%10) + 48;
+                temporaryBytesArray[0] = (getInjectorProgram(&fieldValve[fieldList[iterator]])->offPeriod[2]%10) + 48;
                 transmitNumberToGSM(temporaryBytesArray,1);
                 myMsDelay(10);
-                temporaryBytesArray[0] = (fieldValve[fieldList[iterator]].injector3Cycle%10) + 48;
+                temporaryBytesArray[0] = (getInjectorProgram(&fieldValve[fieldList[iterator]])->cycle[2]%10) + 48;
                 transmitNumberToGSM(temporaryBytesArray,1);
                 myMsDelay(10);
                 transmitStringToGSM(" Inj4: ");
                 myMsDelay(10);
-                temporaryBytesArray[0] = (fieldValve[fieldList[iterator]].injector4OnPeriod%10) + 48;
+                temporaryBytesArray[0] = (getInjectorProgram(&fieldValve[fieldList[iterator]])->onPeriod[3]%10) + 48;
                 transmitNumberToGSM(temporaryBytesArray,1);
                 myMsDelay(10);
-                temporaryBytesArray[0] = (fieldValve[fieldList[iterator]].injector4OffPeriod%10) + 48;
+                temporaryBytesArray[0] = (getInjectorProgram(&fieldValve[fieldList[iterator]])->offPeriod[3]%10) + 48;
                 transmitNumberToGSM(temporaryBytesArray,1);
                 myMsDelay(10);
-                temporaryBytesArray[0] = (fieldValve[fieldList[iterator]].injector4Cycle%10) + 48;
+                temporaryBytesArray[0] = (getInjectorProgram(&fieldValve[fieldList[iterator]])->cycle[3]%10) + 48;
                 transmitNumberToGSM(temporaryBytesArray,1);
                 myMsDelay(10);
                 transmitStringToGSM("\r\n");
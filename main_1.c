@@ -15,6 +15,8 @@
 #include "controllerActions.h"
 #include "eeprom.h"
 #include "gsm.h"
+#include "ADC.h"
+#include "RTC_DS1307.h"
 #ifdef DEBUG_MODE_ON_H
 #include "serialMonitor.h"
 #endif
@@ -37,12 +39,107 @@ void __interrupt(high_priority)rxANDiocInterrupt_handler(void) {
     if (PIR4bits.RC3IF) {
         Run_led = GLOW; // Led Indication for system in Operational Mode
         rxCharacter = rxByte(); // Read byte received at Reception Register
-        // Check if any overrun occur due to continuous reception
-        if (RC3STAbits.OERR) {
+        // Check if any overrun occur due to continuous reception, clear it after bytes in FIFO are read
+        if (RC3STAbits.OERR && !PIR4bits.RC3IF) {
             RC3STAbits.CREN = 0;
             Nop();
             RC3STAbits.CREN = 1;
         }
+    #ifdef SMS_DELIVERY_REPORT_ON_H
+        // Match +CDS delivery report in parallel to response reception and queue it for matching with sent SMS
+        // Check received byte against +CDS: prefix
+        if (deliveryReportIndex < 6) {
+            if (cds[deliveryReportIndex] == rxCharacter) {
+                deliveryReportIndex++;
+                deliveryReportField = CLEAR;
+                deliveryReportQuoted = false;
+                deliveryReportReference = CLEAR;
+                deliveryReportStatus = CLEAR;
+                deliveryReportPdu = false;
+                deliveryReportNibblePending = false;
+                deliveryReportOctet = CLEAR;
+                deliveryReportNextOctet = CLEAR;
+            }
+            else {
+                deliveryReportIndex = (rxCharacter == '+') ? 1 : 0; // Restart matching from received byte
+            }
+        }
+        // Report in PDU mode, SMS-STATUS-REPORT PDU is received in hexadecimal on line after +CDS: <length>
+        else if (deliveryReportPdu) {
+            if ((rxCharacter >= '0' && rxCharacter <= '9') || (rxCharacter >= 'A' && rxCharacter <= 'F')) {
+                deliveryReportValue = (unsigned char)((deliveryReportValue << 4) | ((rxCharacter <= '9') ? (rxCharacter - '0') : (rxCharacter - 'A' + 10)));
+                deliveryReportNibblePending = !deliveryReportNibblePending;
+                // Read service centre length, <mr>, recipient address length and <st> from completed octets
+                if (!deliveryReportNibblePending) {
+                    if (deliveryReportOctet == deliveryReportNextOctet) {
+                        switch (deliveryReportField) {
+                        case 0:
+                            deliveryReportNextOctet = (unsigned char)(deliveryReportValue + 2); // Skip service centre address and first octet
+                            break;
+                        case 1:
+                            deliveryReportReference = deliveryReportValue;
+                            deliveryReportNextOctet++;
+                            break;
+                        case 2:
+                            deliveryReportNextOctet += (unsigned char)(2 + ((deliveryReportValue + 1) >> 1) + 14); // Skip address type, recipient address and time stamps
+                            break;
+                        default:
+                            deliveryReportStatus = deliveryReportValue;
+                            deliveryReportReceived = true;
+                            deliveryReportPdu = false;
+                            deliveryReportIndex = CLEAR;
+                            break;
+                        }
+                        deliveryReportField++;
+                    }
+                    deliveryReportOctet++;
+                }
+            }
+            // PDU ended before status or no PDU followed
+            else if (deliveryReportOctet > 0 || (rxCharacter != '\r' && rxCharacter != '\n')) {
+                deliveryReportPdu = false;
+                deliveryReportIndex = CLEAR;
+            }
+        }
+        // Report is completed at end of line
+        else if (rxCharacter == '\r' || rxCharacter == '\n') {
+            if (deliveryReportField == 6) {
+                deliveryReportReceived = true; // <fo>,<mr>,<ra>,<tora>,<scts>,<dt>,<st> is received
+                deliveryReportIndex = CLEAR;
+            }
+            // Line without fields is +CDS: <length> of report in PDU mode
+            else if (deliveryReportField == 0) {
+                deliveryReportPdu = true;
+            }
+            else {
+                deliveryReportIndex = CLEAR;
+            }
+        }
+        else if (rxCharacter == '"') {
+            deliveryReportQuoted = !deliveryReportQuoted; // Commas within quoted address and time stamps are not separators
+        }
+        else if (rxCharacter == ',' && !deliveryReportQuoted) {
+            deliveryReportField++;
+        }
+        // Accumulate message reference <mr> and status <st>
+        else if (rxCharacter >= '0' && rxCharacter <= '9') {
+            if (deliveryReportField == 1) {
+                deliveryReportReference = (unsigned char)((deliveryReportReference * 10) + (rxCharacter - '0'));
+            }
+            else if (deliveryReportField == 6) {
+                deliveryReportStatus = (unsigned char)((deliveryReportStatus * 10) + (rxCharacter - '0'));
+            }
+        }
+        // Queue completed report, report is dropped if queue is full
+        if (deliveryReportReceived) {
+            deliveryReportReceived = false;
+            if ((unsigned char)((deliveryReportHead + 1) % deliveryReportQueueSize) != deliveryReportTail) {
+                deliveryReportQueue[deliveryReportHead].reference = deliveryReportReference;
+                deliveryReportQueue[deliveryReportHead].status = deliveryReportStatus;
+                deliveryReportHead = (unsigned char)((deliveryReportHead + 1) % deliveryReportQueueSize);
+            }
+        }
+    #endif
         // If interrupt occurred in sleep mode due to command from GSM
         if (inSleepMode) {
             SIM_led = GLOW;  // Led Indication for GSM interrupt in sleep mode 
@@ -81,20 +178,55 @@ void __interrupt(high_priority)rxANDiocInterrupt_handler(void) {
                 gsmResponse[msgIndex] = rxCharacter; // Load received byte into storage buffer
                 msgIndex++; // point to next location for storing next received byte
             }
+            // GSM prompts with '>' to enter SMS text after AT+CMGS command
+            else if (rxCharacter == '>' && msgIndex == 0) {
+                smsPromptReceived = true;
+            }
+        #ifdef BINARY_SMS_ON_H
+            // Pack hexadecimal PDU of SMS read in PDU mode into octets, so that PDU of 140 byte user data fits in storage buffer
+            else if (smsPduDataStarted && msgIndex > 0 && msgIndex < gsmResponseBuffer.capacity && ((rxCharacter >= '0' && rxCharacter <= '9') || (rxCharacter >= 'A' && rxCharacter <= 'F'))) {
+                rxCharacter = (rxCharacter <= '9') ? (unsigned char)(rxCharacter - '0') : (unsigned char)(rxCharacter - 'A' + 10);
+                if (smsPduNibblePending) {
+                    gsmResponse[msgIndex] |= rxCharacter; // Low nibble of octet
+                    msgIndex++;
+                }
+                else {
+                    gsmResponse[msgIndex] = (unsigned char)(rxCharacter << 4); // High nibble of octet
+                }
+                smsPduNibblePending = !smsPduNibblePending;
+            }
+        #endif
             // Cascade received data to stored response after receiving first character '+'
-            else if (msgIndex > 0 && msgIndex <=220) {
+            else if (msgIndex > 0 && msgIndex < gsmResponseBuffer.capacity) {
+            #ifdef BINARY_SMS_ON_H
+                if (smsPduReception && rxCharacter == '\n') {
+                    smsPduDataStarted = true; // PDU follows header line of +CMGR response
+                }
+            #endif
                 gsmResponse[msgIndex] = rxCharacter; // Load received byte into storage buffer
                 // Cascade till 'OK'  is found
                 
                 if (gsmResponse[msgIndex - 1] == 'O' && gsmResponse[msgIndex] == 'K') {
                     controllerCommandExecuted = true; // GSM response to c command is completed
+                    gsmResponseBuffer.length = msgIndex + 1; // Response length including OK
                     msgIndex = CLEAR; // Reset message storage index to first character to start reading for next received byte of cmd
                 } 
                 // Read bytes till 500 characters
-                else if (msgIndex <= 220) {
+                else if (msgIndex < gsmResponseBuffer.capacity) {
                     msgIndex++;
                 }
             }
+            // Drop rest of response longer than storage buffer till 'OK', so that it does not spill into response of next command
+            else if (msgIndex > 0) {
+                if (gsmResponse[gsmResponseBuffer.capacity - 1] == 'O' && rxCharacter == 'K') {
+                    controllerCommandExecuted = true; // GSM response to c command is completed
+                    gsmResponseBuffer.length = gsmResponseBuffer.capacity; // Truncated response
+                    msgIndex = CLEAR;
+                }
+                else {
+                    gsmResponse[gsmResponseBuffer.capacity - 1] = rxCharacter; // Last byte is kept only to find 'OK'
+                }
+            }
         }
         SIM_led = DARK;  // Led Indication for GSM interrupt is done 
         PIR4bits.RC3IF= CLEAR; // Reset the ISR flag.
@@ -102,23 +234,15 @@ void __interrupt(high_priority)rxANDiocInterrupt_handler(void) {
     //Interrupt-on-change pins
     else if (PIR0bits.IOCIF) {
         Run_led = GLOW; // Led Indication for system in Operational Mode
-        // Rising Edge -- All phase present
+        // Rising/Falling Edge -- Any phase changed
         if ((IOCEF5 == 1 || IOCEF6 == 1 || IOCEF7 == 1)) {
-            myMsDelay(5000);
-            if (phaseB == 0 && phaseY == 0 &&  phaseR == 0) {
-                //phase is on
-                IOCEF &= (IOCEF ^ 0xFF); //Clearing Interrupt Flags
-                phaseFailureDetected = false;
-                setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                myMsDelay(5000);
-                RESET();
-            }
-            else {
-                // phase is out
-                IOCEF &= (IOCEF ^ 0xFF); //Clearing Interrupt Flags
-                phaseFailureDetected = true; //true
-                phaseFailureActionTaken = false;
-            }
+            IOCEF &= (IOCEF ^ 0xFF); //Clearing Interrupt Flags
+            // Restart hold off period from this edge, phase status is resolved in Timer5 interrupt
+            T5CONbits.TMR5ON = OFF;
+            TMR5H = (unsigned char)(phaseHoldOffCount >> 8); // Load Timer5 Register Higher Byte
+            TMR5L = (unsigned char)(phaseHoldOffCount & 0xFF); // Load Timer5 Register lower Byte
+            PIR5bits.TMR5IF = CLEAR;
+            T5CONbits.TMR5ON = ON;
         }
         PIR0bits.IOCIF = CLEAR; // Reset the ISR flag.
     }          
@@ -140,6 +264,7 @@ void __interrupt(low_priority) timerInterrupt_handler(void) {
         TMR0H = 0xE3; // Load Timer0 Register Higher Byte 
         TMR0L = 0xB0; // Load Timer0 Register Lower Byte
         Timer0Overflow++;
+        advanceSystemClock(60); // Advance system clock by one minute
         // Control sleep count decrement for each one minute interrupt when Motor is ON i.e. Valve ON period 
         if (sleepCount > 0 && MotorControl == ON) {
             sleepCount--;
@@ -285,6 +410,54 @@ void __interrupt(low_priority) timerInterrupt_handler(void) {
             filtrationCycleSequence = 1;
         }
     }
+/*To sample motor CT output on each Timer2 triggered ADC conversion*/
+    if (PIE1bits.ADIE && PIR1bits.ADIF) {
+        PIR1bits.ADIF = CLEAR;
+        accumulateMotorCurrentSample();
+    }
+/*To store average of each analog channel at end of burst in background scan*/
+    if (PIE1bits.ADTIE && PIR1bits.ADTIF) {
+        PIR1bits.ADTIF = CLEAR;
+        storeAnalogScanResult();
+    }
+/*To resolve RYB phase status after phase lines are stable for hold off period*/
+    if (PIR5bits.TMR5IF) {
+        PIR5bits.TMR5IF = CLEAR;
+        T5CONbits.TMR5ON = OFF; // Stop hold off timer
+        phaseStatus = CLEAR;
+        if (phaseR) {
+            phaseStatus |= phaseRLost;
+        }
+        if (phaseY) {
+            phaseStatus |= phaseYLost;
+        }
+        if (phaseB) {
+            phaseStatus |= phaseBLost;
+        }
+        // phase is out
+        if (phaseStatus != CLEAR) {
+            if (!phaseFailureDetected) {
+                phaseFailureDetected = true;
+                phaseFailureActionTaken = false;
+            }
+            phaseRestored = false;
+        }
+        // phase is on
+        else if (phaseFailureDetected) {
+            phaseFailureDetected = false;
+            phaseRestored = true;
+        }
+    }
+/*To follow I2C transaction on completion of each bus event*/
+    if (PIE3bits.SSP2IE && PIR3bits.SSP2IF) {
+        PIR3bits.SSP2IF = CLEAR;
+        serviceI2CInterrupt();
+    }
+/*To abort I2C transaction on bus collision*/
+    if (PIE3bits.BCL2IE && PIR3bits.BCL2IF) {
+        PIR3bits.BCL2IF = CLEAR;
+        abortI2CTransaction();
+    }
 /*To measure pulse width of moisture sensor output*/
     if (PIR5bits.TMR1IF) {
         Run_led = GLOW; // Led Indication for system in Operational Mode
@@ -363,14 +536,7 @@ nxtVlv: if (!valveDue && !phaseFailureDetected && !lowPhaseCurrentDetected) {
                 iterator++;
             }   
             /***************************/
-            sendSms(SmsIrr5, userMobileNo, commonInActiveFieldNoRequired); // Acknowledge user about successful Irrigation stopped action
-        #ifdef SMS_DELIVERY_REPORT_ON_H
-            sleepCount = 2; // Load sleep count for SMS transmission action
-            sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-            setBCDdigit(0x05,0);
-            deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-            setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-        #endif
+            queueSms(SmsIrr5, commonInActiveFieldNoRequired, smsAcknowledgement); // Acknowledge user about successful Irrigation stopped action
             /***************************/
             // Reset De-active Valve list
             iterator = 0;
@@ -382,14 +548,7 @@ nxtVlv: if (!valveDue && !phaseFailureDetected && !lowPhaseCurrentDetected) {
             //deActivateValve(last_Field_No);      // Successful Deactivate valve
             valveExecuted = false;
             /***************************/
-            sendSms(SmsMotor1, userMobileNo, noInfo); // Acknowledge user about successful action
-        #ifdef SMS_DELIVERY_REPORT_ON_H
-            sleepCount = 2; // Load sleep count for SMS transmission action
-            sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-            setBCDdigit(0x05,0);
-            deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-            setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-        #endif
+            queueSms(SmsMotor1, noInfo, smsAcknowledgement); // Acknowledge user about successful action
             /***************************/
             //startFieldNo = 0;
             //goto nxtVlv;
@@ -443,15 +602,8 @@ nxtVlv: if (!valveDue && !phaseFailureDetected && !lowPhaseCurrentDetected) {
             #endif
                 if (isRTCBatteryDrained() && !rtcBatteryLevelChecked){
                     /***************************/
-                    sendSms(SmsRTC1, userMobileNo, noInfo); // Acknowledge user about replace RTC battery
+                    queueSms(SmsRTC1, noInfo, alertRtcBattery); // Acknowledge user about replace RTC battery
                     rtcBatteryLevelChecked = true;
-                #ifdef SMS_DELIVERY_REPORT_ON_H
-                    sleepCount = 2; // Load sleep count for SMS transmission action
-                    sleepCountChangedDueToInterrupt = true; // Sleep count needs to read from memory after SMS transmission
-                    setBCDdigit(0x05,0);
-                    deepSleep(); // Sleep until message transmission acknowledge SMS is received from service provider
-                    setBCDdigit(0x0F,0); // Blank "." BCD Indication for Normal Condition
-                #endif
                     /***************************/
                 }
             }
@@ -15,6 +15,7 @@
 #include "controllerActions.h"
 #include "eeprom.h"
 #include "gsm.h"
+#include "RTC_DS1307.h"
 #ifdef DEBUG_MODE_ON_H
 #include "serialMonitor.h"
 #endif
@@ -82,7 +83,7 @@ void __interrupt(high_priority)rxANDiocInterrupt_handler(void) {
                 msgIndex++; // point to next location for storing next received byte
             }
             // Cascade received data to stored response after receiving first character '+'
-            else if (msgIndex > 0 && msgIndex <=220) {
+            else if (msgIndex > 0 && msgIndex < gsmResponseSize) {
                 gsmResponse[msgIndex] = rxCharacter; // Load received byte into storage buffer
                 // Cascade till 'OK'  is found
                 
@@ -91,7 +92,7 @@ void __interrupt(high_priority)rxANDiocInterrupt_handler(void) {
                     msgIndex = CLEAR; // Reset message storage index to first character to start reading for next received byte of cmd
                 } 
                 // Read bytes till 500 characters
-                else if (msgIndex <= 220) {
+                else if (msgIndex < gsmResponseSize) {
                     msgIndex++;
                 }
             }
@@ -285,6 +286,16 @@ void __interrupt(low_priority) timerInterrupt_handler(void) {
             filtrationCycleSequence = 1;
         }
     }
+/*To follow I2C transaction on completion of each bus event*/
+    if (PIE3bits.SSP2IE && PIR3bits.SSP2IF) {
+        PIR3bits.SSP2IF = CLEAR;
+        serviceI2CInterrupt();
+    }
+/*To abort I2C transaction on bus collision*/
+    if (PIE3bits.BCL2IE && PIR3bits.BCL2IF) {
+        PIR3bits.BCL2IF = CLEAR;
+        abortI2CTransaction();
+    }
 /*To measure pulse width of moisture sensor output*/
     if (PIR5bits.TMR1IF) {
         Run_led = GLOW; // Led Indication for system in Operational Mode
@@ -0,0 +1,83 @@
+/*
+ * File name            : numberFormat.c
+ * Compiler             : MPLAB XC8/ MPLAB C18 compiler
+ * IDE                  : Microchip  MPLAB X IDE v5.25
+ * Processor            : PIC18F66K40
+ * Author               : Bhoomi Jalasandharan
+ * Created on           : July 15, 2020, 05:23 PM
+ * Description          : division free number to ASCII formatting functions definitions source file
+ */
+
+#include "congfigBits.h"
+#include "variableDefinitions.h"
+#include "numberFormat.h"
+
+// Powers of ten subtracted to get each decimal digit of 16 bit number
+const unsigned int powersOfTen[5] = {10000, 1000, 100, 10, 1};
+
+// ASCII digit pairs of 00 to 99, two digit number n is at index 2n
+const unsigned char twoDigitTable[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+//*****************Number formatting function_Start****************//
+
+/*************************************************************************************************************************
+
+This function is called to convert 16 bit number into ASCII digits for SMS and debug messages
+The purpose of this function is to store given no. of least significant digits of number with leading zeros.
+Each digit is counted by subtracting power of ten, as division is costly on 8 bit core.
+
+ **************************************************************************************************************************/
+void formatNumber(unsigned int number, unsigned char *string, unsigned char width) {
+    unsigned char index, digit;
+    if (width > 5) {
+        width = 5;
+    }
+    for (index = 0; index < 5; index++) {
+        digit = '0';
+        while (number >= powersOfTen[index]) {
+            number -= powersOfTen[index];
+            digit++;
+        }
+        // Digits above given width are dropped
+        if (index >= 5 - width) {
+            *string++ = digit;
+        }
+    }
+}
+
+/*************************************************************************************************************************
+
+This function is called to convert number below 100 into ASCII digits for date, time and field no.
+The purpose of this function is to store 2 digits of number from digit pair table.
+
+ **************************************************************************************************************************/
+void formatTwoDigits(unsigned char number, unsigned char *string) {
+    while (number >= 100) {
+        number -= 100; // Only last 2 digits are stored
+    }
+    number <<= 1;
+    string[0] = twoDigitTable[number];
+    string[1] = twoDigitTable[number + 1];
+}
+
+/*************************************************************************************************************************
+
+This function is called to convert field index into field no. for SMS
+The purpose of this function is to store field no. "01" to "12" of field index 0 to 11.
+
+ **************************************************************************************************************************/
+void formatFieldNo(unsigned char fieldNo, unsigned char *string) {
+    formatTwoDigits(fieldNo + 1, string);
+}
+
+//*****************Number formatting function_End****************//
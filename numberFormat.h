@@ -0,0 +1,23 @@
+/*
+ * File name            : numberFormat.h
+ * Compiler             : MPLAB XC8/ MPLAB C18 compiler
+ * IDE                  : Microchip  MPLAB X IDE v5.25
+ * Processor            : PIC18F66K40
+ * Author               : Bhoomi Jalasandharan
+ * Created on           : July 15, 2020, 05:23 PM
+ * Description          : division free number to ASCII formatting functions header file
+ */
+
+#ifndef NUMBER_FORMAT_H
+#define	NUMBER_FORMAT_H
+
+/****************Number formatting functions declarations#start ****/
+
+void formatNumber(unsigned int, unsigned char *, unsigned char); // To convert number into zero padded ASCII digits of given width
+void formatTwoDigits(unsigned char, unsigned char *); // To convert number below 100 into 2 ASCII digits
+void formatFieldNo(unsigned char, unsigned char *); // To convert field index 0-11 into field no. "01"-"12"
+
+/****************Number formatting functions declarations#end ******/
+
+#endif
+/* NUMBER_FORMAT_H */
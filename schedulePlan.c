@@ -0,0 +1,187 @@
+/*
+ * File name            : schedulePlan.c
+ * Compiler             : MPLAB XC8/ MPLAB C18 compiler
+ * IDE                  : Microchip  MPLAB X IDE v5.25
+ * Processor            : PIC18F66K40
+ * Author               : Bhoomi Jalasandharan
+ * Created on           : July 15, 2020, 05:23 PM
+ * Description          : schedule plan forward simulation functions definitions source file
+ */
+
+#include "schedulePlan.h"
+
+// Days of year before first day of each month in non leap year
+const unsigned int planMonthStart[13] = {0, 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+
+/*************************************************************************************************************************
+
+This function is called to convert date into day number
+The purpose of this function is to return no. of days from 01/01/00 to given date so that dates are compared and shifted by subtraction.
+
+ **************************************************************************************************************************/
+unsigned int getPlanDayNumber(unsigned char dd, unsigned char mm, unsigned char yy) {
+    unsigned int dayNumber;
+    if (mm < 1 || mm > 12) {
+        mm = 1;
+    }
+    dayNumber = (unsigned int)yy * 365 + (((unsigned int)yy + 3) >> 2); // One extra day for each leap year before given year
+    dayNumber += planMonthStart[mm];
+    if ((yy & 0x03) == 0 && mm > 2) {
+        dayNumber++; // 29th February of given year
+    }
+    return dayNumber + dd - 1;
+}
+
+/*************************************************************************************************************************
+
+This function is called to convert day number into date
+The purpose of this function is to return day and month of date which is given no. of days after 01/01/00.
+
+ **************************************************************************************************************************/
+void getPlanDate(unsigned int dayNumber, unsigned char *dd, unsigned char *mm) {
+    unsigned char yy = 0;
+    unsigned int monthStart;
+    while (dayNumber >= ((yy & 0x03) ? 365 : 366)) {
+        dayNumber -= ((yy & 0x03) ? 365 : 366);
+        yy++;
+    }
+    for (*mm = 12; *mm > 1; (*mm)--) {
+        monthStart = planMonthStart[*mm];
+        if ((yy & 0x03) == 0 && *mm > 2) {
+            monthStart++;
+        }
+        if (dayNumber >= monthStart) {
+            break;
+        }
+    }
+    monthStart = planMonthStart[*mm];
+    if ((yy & 0x03) == 0 && *mm > 2) {
+        monthStart++;
+    }
+    *dd = (unsigned char)(dayNumber - monthStart + 1);
+}
+
+/*************************************************************************************************************************
+
+This function is called to simulate valve schedule forward on copy of valve table
+The purpose of this function is to list valve actions taken from startMinute until endMinute by the same rules as controller:
+priorities are scanned from nextPriority and wrapped once, valve due for date is taken before valve due for cycles,
+valves of same priority due at same time or due for cycles are switched on in parallel,
+next due date is set offPeriod days after start of first cycle and fertigation instances are consumed on each fertigated action.
+Moisture sensors, phase failures and hold commands are not simulated i.e. every field is taken as dry.
+No. of actions listed in event[] is returned, simulation stops when eventCapacity actions are listed.
+
+ **************************************************************************************************************************/
+unsigned char runSchedulePlan(struct PLANVALVE *valve, unsigned char valveCount, unsigned char nextPriority, unsigned int startMinute, unsigned int endMinute, struct PLANEVENT *event, unsigned char eventCapacity) {
+    unsigned long now = startMinute;
+    unsigned long nearest;
+    long dueMinute;
+    unsigned char eventCount = 0;
+    unsigned char maxPriority;
+    unsigned char field_No;
+    unsigned char dueField;
+    unsigned int fieldMask;
+    _Bool dueForCycles;
+    _Bool firstPriorityChecked;
+    while (now < endMinute && eventCount < eventCapacity) {
+        maxPriority = 0;
+        for (field_No = 0; field_No < valveCount; field_No++) {
+            if (valve[field_No].isConfigured && valve[field_No].priority > maxPriority) {
+                maxPriority = valve[field_No].priority;
+            }
+        }
+        if (maxPriority == 0) {
+            break;
+        }
+        if (nextPriority > maxPriority || nextPriority == 0) {
+            nextPriority = 1;
+        }
+        // Scan priorities for due valve as in scanValveScheduleAndGetSleepCount
+        dueField = valveCount;
+        dueForCycles = false;
+        firstPriorityChecked = false;
+        nearest = 0xFFFFFFFF;
+        while (1) {
+            for (field_No = 0; field_No < valveCount; field_No++) {
+                if (!valve[field_No].isConfigured || valve[field_No].priority != nextPriority) {
+                    continue;
+                }
+                dueMinute = (long)valve[field_No].dueDay * planMinutesOfDay + valve[field_No].motorOnMinute;
+                if (dueMinute <= (long)now) {
+                    dueField = field_No;
+                    break;
+                }
+                else if (valve[field_No].cyclesExecuted < valve[field_No].cycles) {
+                    dueField = field_No;
+                    dueForCycles = true;
+                    break;
+                }
+                else if ((unsigned long)dueMinute < nearest) {
+                    nearest = (unsigned long)dueMinute;
+                }
+            }
+            if (dueField < valveCount) {
+                break;
+            }
+            if (nextPriority == 1) {
+                firstPriorityChecked = true;
+            }
+            nextPriority++;
+            if (nextPriority > maxPriority) {
+                if (firstPriorityChecked) {
+                    break;
+                }
+                nextPriority = 1;
+            }
+        }
+        // Sleep until nearest due valve
+        if (dueField == valveCount) {
+            now = nearest;
+            continue;
+        }
+        // Fetch parallel valves as in fetchParallelValveList
+        fieldMask = 0;
+        for (field_No = 0; field_No < valveCount; field_No++) {
+            if (!valve[field_No].isConfigured || valve[field_No].priority != valve[dueField].priority) {
+                continue;
+            }
+            if (field_No == dueField
+                || (dueForCycles && valve[field_No].cyclesExecuted < valve[field_No].cycles)
+                || (!dueForCycles && valve[field_No].dueDay == valve[dueField].dueDay && valve[field_No].motorOnMinute == valve[dueField].motorOnMinute)) {
+                fieldMask |= 1U << field_No;
+                if (!dueForCycles) {
+                    valve[field_No].cyclesExecuted = valve[field_No].cycles;
+                }
+            }
+        }
+        event[eventCount].startMinute = (unsigned int)now;
+        event[eventCount].fieldMask = fieldMask;
+        event[eventCount].duration = valve[dueField].onPeriod;
+        if (valve[dueField].isFertigationEnabled && valve[dueField].fertigationInstance != 0) {
+            event[eventCount].fieldMask |= planFertigationFlag;
+        }
+        // Update valves of action as in actionsOnDueValve and actionsOnSleepCountFinish
+        for (field_No = 0; field_No < valveCount; field_No++) {
+            if (!(fieldMask & (1U << field_No))) {
+                continue;
+            }
+            if (valve[field_No].cyclesExecuted == valve[field_No].cycles) {
+                valve[field_No].dueDay = (int)(now / planMinutesOfDay) + valve[field_No].offPeriod;
+                valve[field_No].cyclesExecuted = 1; // Cycles execution begin after valve due for first time
+            }
+            else {
+                valve[field_No].cyclesExecuted++;
+            }
+            if ((event[eventCount].fieldMask & planFertigationFlag) && valve[field_No].isFertigationEnabled && valve[field_No].fertigationInstance != 0) {
+                valve[field_No].fertigationInstance--;
+                if (valve[field_No].fertigationInstance == 0) {
+                    valve[field_No].isFertigationEnabled = false;
+                }
+            }
+        }
+        now += valve[dueField].onPeriod;
+        nextPriority = valve[dueField].priority + 1;
+        eventCount++;
+    }
+    return eventCount;
+}
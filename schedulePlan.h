@@ -0,0 +1,58 @@
+/*
+ * File name            : schedulePlan.h
+ * Compiler             : MPLAB XC8/ MPLAB C18 compiler
+ * IDE                  : Microchip  MPLAB X IDE v5.25
+ * Processor            : PIC18F66K40
+ * Author               : Bhoomi Jalasandharan
+ * Created on           : July 15, 2020, 05:23 PM
+ * Description          : schedule plan forward simulation functions header file
+ */
+
+#ifndef SCHEDULE_PLAN_H
+#define	SCHEDULE_PLAN_H
+
+/*
+ * Schedule plan engine does not use any controller register or global variable,
+ * so the same source is built for PIC and on host (any C99 compiler) for what-if analysis of valve tables.
+ * Plan time is counted in minutes from 00:00 of day on which plan starts i.e. day 0.
+ */
+
+#include <stdbool.h>
+
+/***************************** Plan valve structure declaration#start ***************/
+struct PLANVALVE {
+    unsigned char priority;             // Priority of valve, 0 for valve not configured
+    unsigned isConfigured : 1;          // Valve is configured
+    unsigned isFertigationEnabled : 1;  // Fertigation is enabled for remaining instances
+    unsigned char cycles;               // Cycles to be executed on each due date
+    unsigned char cyclesExecuted;       // Cycles executed since last due date
+    unsigned char offPeriod;            // Days between due dates
+    unsigned char fertigationInstance;  // Remaining fertigation instances
+    unsigned int motorOnMinute;         // Motor on time as minutes of day
+    unsigned int onPeriod;              // Valve on period in minutes
+    int dueDay;                         // Next due date as day of plan, negative for over passed due date
+};
+/***************************** Plan valve structure declaration#end *****************/
+
+/***************************** Plan event structure declaration#start ***************/
+struct PLANEVENT {
+    unsigned int startMinute;           // Start time of valve action in minutes of plan
+    unsigned int fieldMask;             // Fields switched on in parallel, field 1 at bit 0, planFertigationFlag if fertigated
+    unsigned int duration;              // On period of valve action in minutes
+};
+/***************************** Plan event structure declaration#end *****************/
+
+#define planFertigationFlag 0x8000 // Set in field mask of event started with fertigation
+#define planMinutesOfDay 1440
+#define planMaxDays 44 // End of plan in minutes of plan fits in 16 bit
+
+/****************Schedule plan functions declarations#start ****/
+
+unsigned int getPlanDayNumber(unsigned char, unsigned char, unsigned char); // To convert date DD/MM/YY into days since 01/01/00
+void getPlanDate(unsigned int, unsigned char *, unsigned char *); // To convert days since 01/01/00 into day and month
+unsigned char runSchedulePlan(struct PLANVALVE *, unsigned char, unsigned char, unsigned int, unsigned int, struct PLANEVENT *, unsigned char); // To simulate valve schedule forward and list valve actions
+
+/****************Schedule plan functions declarations#end ******/
+
+#endif
+/* SCHEDULE_PLAN_H */
@@ -27,6 +27,18 @@
 #endif
 */
 
+/*
+#ifndef BINARY_SMS_ON_H // Binary command and status frames in 8 bit SMS
+#define	BINARY_SMS_ON_H
+#endif
+*/
+
+/*
+#ifndef GSM_FLOW_CONTROL_ON_H // RTS/CTS flow control on GSM link
+#define	GSM_FLOW_CONTROL_ON_H
+#endif
+*/
+
 /*
 #ifndef DOL_DEFINITIONS_H // for direct online motor start
 #define DOL_DEFINITIONS_H
@@ -41,6 +53,7 @@
 
 // include processor files - each processor file is guarded.  
 #include "congfigBits.h"
+#include "schedulePlan.h"
 
 #define Major "0"
 #define Minor "7"
@@ -95,6 +108,9 @@
 
 #define RTC_Trigger PORTGbits.RG4                 // RTC Battery measurement control liine
 
+#define gsmRTS LATCbits.LATC0                   // GSM flow control output -- LOW when controller can receive
+#define gsmCTS PORTCbits.RC1                    // GSM flow control input -- LOW when GSM can receive
+
 #define phaseR PORTEbits.RE7                    // R Phase input
 #define phaseY PORTEbits.RE6                    // Y Phase input
 #define phaseB PORTEbits.RE5                    // B Phase input
@@ -103,6 +119,13 @@
 #define dp PORTDbits.RD7
 /***************************** Port line definition#end ******************************/
 
+/***************************** Moisture sensor definitions#start **************/
+#define moistureFrequencyConstant 160000UL // Timer1 counts per sec /100 to convert moisture frequency from 5 digit to 3 digit
+#define moisturePeriodMax 0xFFFF // Sensor cycle width for failed sensor or frequency below measurable range
+#define moistureReadingMaxAge 10 // Minutes for which measured moisture level of field is used without measuring again
+#define moistureProbeOverflows 3 // Timer1 overflows within which sensor output of measurable range changes level
+/***************************** Moisture sensor definitions#end ****************/
+
 /***************************** Analog pin definitions#start **************/
 #define CT 0b00011000
 #define WindSpeed 0b00011001
@@ -113,8 +136,54 @@
 #define WSchannel 1
 #define TPchannel 2
 #define RTCchannel 3
+
+#define ctSamplesPerWindow 200 // CT samples at 1 msec for 10 mains cycles of 50 Hz (12 cycles of 60 Hz)
+#define ctSamplingTimeout 400 // Max wait in msec for one sampling window, sampling is aborted if ADC interrupt is not received
+#define analogScanTimeout 100 // Max wait in msec for background scan of analog channels, scan is aborted if ADC threshold interrupt is not received
+#define motorLoadScaleVersion 0xA2 // Saved with motor load cut-offs -- AC RMS of CT output with DC offset removed
+#define ctAutoConversionTrigger 0x04 // ADC auto conversion trigger source -- TMR2 postscaled
+#define analogSamplesPerChannel 16 // Conversions accumulated by ADC computation unit for each channel in background scan
+#define analogBurstAverageMode 0b01000011 // ADCON2 -- Burst average mode, accumulator right shifted by 4 for average of 16
+#define analogThresholdAlways 0b00000111 // ADCON3 -- Threshold interrupt at end of every burst
+#define rtcScanInterval 16 // RTC battery is measured in every 16th background scan
 /***************************** Analog pin definition#end ****************/
 
+/***************************** I2C definitions#start **************/
+#define i2cQueueSize 4 // No. of I2C transactions that can be queued, power of 2
+#define rtcSlaveAddress 0xD0 // DS1307 slave address with write mode
+#define rtcSecondsRegister 0x00 // DS1307 address of seconds register
+#define rtcRegisterCount 7 // DS1307 time and date registers -- seconds, minutes, hour, day, date, month, year
+#define rtcTransferTimeout 50 // Max wait in msec for burst transfer of RTC registers, transfer takes about 1 msec
+#define i2cStateIdle 0
+#define i2cStateStart 1
+#define i2cStateAddress 2
+#define i2cStateRegister 3
+#define i2cStateWrite 4
+#define i2cStateRestart 5
+#define i2cStateReadAddress 6
+#define i2cStateReceive 7
+#define i2cStateAcknowledge 8
+#define i2cStateStop 9
+/***************************** I2C definitions#end ****************/
+
+/***************************** GSM link definitions#start **************/
+#define gsmBaudRate9600 0x0681 // SP3BRG for 9600 baud at Fosc=64Mhz with BRGH=1 BRG16=1
+#define gsmBaudRate115200 0x008A // SP3BRG for 115200 baud at Fosc=64Mhz with BRGH=1 BRG16=1
+#define gsmCtsTimeout 1000 // Max wait in msec for GSM to release CTS before byte is sent
+/***************************** GSM link definitions#end ****************/
+
+/***************************** System clock definitions#start **************/
+#define sleepCountPeriod 68 // Seconds per sleep count -- sleep count is calculated as minutes * 15/17
+/***************************** System clock definitions#end ****************/
+
+/***************************** Phase monitor definitions#start **************/
+#define phaseHoldOffPeriod 5 // Time in seconds (1-16) for which RYB phase lines must be stable before phase status is changed
+#define phaseHoldOffCount (65536 - (phaseHoldOffPeriod * 3875)) // Timer5 load value for hold off period at LFINTOSC/8
+#define phaseRLost 0x01
+#define phaseYLost 0x02
+#define phaseBLost 0x04
+/***************************** Phase monitor definition#end ****************/
+
 /***************************** Device Reset Type definitions#start **************/
 #define PowerOnReset 1
 #define LowPowerReset 2
@@ -148,44 +217,113 @@
 
 /***************************** Field Valve structure declaration#start ***************/
 struct FIELDVALVE {
-    unsigned int dryValue;              // 16 BIT  --2 LOCATION 0,1
-    unsigned int wetValue;              // 16 BIT  --2 LOCATION 2,3
-    unsigned int onPeriod;             	// 16 BIT  --2 LOCATION 4,5
-    unsigned int fertigationDelay;      // 16 BIT  --2 LOCATION 6,7
-    unsigned int fertigationONperiod;   // 16 BIT  --2 LOCATION 8,9
-    unsigned int injector1OnPeriod;     // 16 BIT  --2 LOCATION 10,11
-    unsigned int injector2OnPeriod;     // 16 BIT  --2 LOCATION 12,13
-    unsigned int injector3OnPeriod;     // 16 BIT  --2 LOCATION 14,15
-    unsigned int injector4OnPeriod;     // 16 BIT  --2 LOCATION 16,17
-    unsigned int injector1OffPeriod;    // 16 BIT  --2 LOCATION 18,19  
-    unsigned int injector2OffPeriod;    // 16 BIT  --2 LOCATION 20,21
-    unsigned int injector3OffPeriod;    // 16 BIT  --2 LOCATION 22,23
-    unsigned int injector4OffPeriod;    // 16 BIT  --2 LOCATION 24,25
-    unsigned char injector1Cycle;       //  8 BIT  --1 LOCATION 26
-    unsigned char injector2Cycle;       //  8 BIT  --1 LOCATION 27
-    unsigned char injector3Cycle;       //  8 BIT  --1 LOCATION 28
-    unsigned char injector4Cycle;       //  8 BIT  --1 LOCATION 29
-    unsigned char offPeriod;            //  8 BIT  --1 LOCATION 30
+    /* Fields read by schedule scan on each wake are placed first */
+    unsigned char priority;             //  8 BIT  --1 LOCATION 37
+    unsigned status : 1;                //  1 BIT  --1 LOCATION 41
+    unsigned isConfigured : 1;          //  1 BIT  --1 LOCATION 42
+    unsigned isFertigationEnabled : 1;  //  1 BIT  --1 LOCATION 43
+    unsigned fertigationValveInterrupted : 1; //  1 BIT  --1 LOCATION 44
+    unsigned fertigationStage : 3;      //  3 BIT  --1 LOCATION 38, erased location reads as no stage
     unsigned char motorOnTimeHour;      //  8 BIT  --1 LOCATION 31
     unsigned char motorOnTimeMinute;    //  8 BIT  --1 LOCATION 32
     unsigned char nextDueDD;            //  8 BIT  --1 LOCATION 33
     unsigned char nextDueMM;            //  8 BIT  --1 LOCATION 34
     unsigned char nextDueYY;            //  8 BIT  --1 LOCATION 35
-    unsigned char fertigationInstance;  //  8 BIT  --1 LOCATION 36
-	unsigned char priority;             //  8 BIT  --1 LOCATION 37
-    unsigned char fertigationStage;     //  8 BIT  --1 LOCATION 38
     unsigned char cycles;               //  8 BIT  --1 LOCATION 39
     unsigned char cyclesExecuted;       //  8 BIT  --1 LOCATION 40
-    _Bool status;                       //  8 BIT  --1 LOCATION 41
-    _Bool isConfigured;                 //  8 BIT  --1 LOCATION 42
-    _Bool isFertigationEnabled;         //  8 BIT  --1 LOCATION 43
-    _Bool fertigationValveInterrupted;  //  8 BIT  --1 LOCATION 44
+    unsigned int onPeriod;             	// 16 BIT  --2 LOCATION 4,5
+    unsigned char offPeriod;            //  8 BIT  --1 LOCATION 30
+    unsigned int dryValue;              // 16 BIT  --2 LOCATION 0,1
+    unsigned int wetValue;              // 16 BIT  --2 LOCATION 2,3
+    unsigned int wetValuePeriod;        // 16 BIT  --RAM only, wet value as sensor cycle width, 0 until converted
+    unsigned int fertigationDelay;      // 16 BIT  --2 LOCATION 6,7
+    unsigned int fertigationONperiod;   // 16 BIT  --2 LOCATION 8,9
+    unsigned char fertigationInstance;  //  8 BIT  --1 LOCATION 36
+    unsigned char injectorSlot;         //  8 BIT  --RAM only, index in injectorProgram[] or noInjectorProgram
 };
 /***************************** Field Valve structure declaration#end *****************/
 
+/***************************** Injector program structure declaration#start ***************/
+struct INJECTORPROGRAM {
+    unsigned int onPeriod[4];           // 16 BIT  --2 LOCATION 10,11 12,13 14,15 16,17 of field valve
+    unsigned int offPeriod[4];          // 16 BIT  --2 LOCATION 18,19 20,21 22,23 24,25 of field valve
+    unsigned char cycle[4];             //  8 BIT  --1 LOCATION 26 27 28 29 of field valve
+};
+#define injectorProgramCount 8 // Injectors are driven only when fields 9-12 are free, so at most 8 fertigated priorities use them
+#define noInjectorProgram 0xFF // Valve fertigates without injectors i.e. all injector periods are zero
+/***************************** Injector program structure declaration#end *****************/
+
+/***************************** Message buffer structure declaration#start ***************/
+struct MESSAGEBUFFER {
+    unsigned char *data;                // Storage of message
+    unsigned char length;               // No. of valid bytes in storage
+    unsigned char capacity;             // Size of storage
+};
+/***************************** Message buffer structure declaration#end *****************/
+
+/***************************** I2C transaction structure declaration#start ***************/
+struct I2CTRANSACTION {
+    unsigned char slaveAddress;         // Slave address with write mode
+    unsigned char registerAddress;      // Register pointer of slave
+    unsigned char *data;                // Bytes to be written or buffer for bytes to be read
+    unsigned char length;               // No. of bytes to be transferred
+    _Bool read;                         // Read transaction if true, Write transaction if false
+    void (*callback)(_Bool);            // Called from I2C interrupt on completion with success status
+};
+/***************************** I2C transaction structure declaration#end *****************/
+
+/***************************** SMS delivery structure declaration#start ***************/
+struct SMSDELIVERY {
+    const char *message;                // Message of SMS to be sent again on failed delivery
+    unsigned char info;                 // Additional info of SMS
+    unsigned char fieldNo[2];           // Field no. given in additional info of SMS
+    unsigned char reference;            // Message reference given by GSM in +CMGS response
+    unsigned char status;               // Delivery status of SMS
+    unsigned char retries;              // No. of times SMS is sent again
+    unsigned int sentDay;               // Day number of date on which SMS is sent
+    unsigned int sentMinute;            // Minute of day at which SMS is sent
+};
+#define smsDeliveryCount 4              // No. of last SMS tracked for delivery report
+#define smsDeliveryMaxRetries 2         // No. of times SMS is sent again on failed delivery
+#define smsDeliveryFree 0               // Slot is not used
+#define smsDeliveryPending 1            // SMS is sent, delivery report is awaited
+#define smsDeliveryDelivered 2          // SMS is delivered to recipient
+#define smsDeliveryFailed 3             // SMS is not sent or not delivered, to be sent again
+#define smsDeliveryAbandoned 4          // SMS is not delivered even after retries or cannot be sent again
+#define smsDeliveryExpired 5            // Delivery report is not received within timeout
+#define smsDeliveryTimeout 720          // Minutes for which delivery report of sent SMS is awaited
+struct DELIVERYREPORT {
+    unsigned char reference;            // Message reference of received delivery report
+    unsigned char status;               // Delivery status of received delivery report
+};
+#define deliveryReportQueueSize 8       // No. of received delivery reports queued for matching plus one
+/***************************** SMS delivery structure declaration#end *****************/
+
+/***************************** Alert window structure declaration#start ***************/
+struct ALERTWINDOW {
+    unsigned int startDay;              // Day number of date on which first alert of window is sent
+    unsigned int startMinute;           // Minute of day at which first alert of window is sent
+    unsigned char startHour;            // Hour at which first alert of window is sent
+    unsigned char startMinutes;         // Minutes at which first alert of window is sent
+    unsigned char occurrences;          // No. of alerts raised within window including first
+    unsigned char summaryOccurrences;   // No. of alerts of closed windows yet to be reported in summary
+    unsigned char summaryHour;          // Hour at which first closed window yet to be reported is opened
+    unsigned char summaryMinutes;       // Minutes at which first closed window yet to be reported is opened
+};
+/***************************** Alert window structure declaration#end *****************/
+
 /************* statically allocated initialized user variables#start *****/
 #pragma idata fieldValve
 struct FIELDVALVE fieldValve[12] = {0}; //Initialize field valve structure to zero
+#pragma idata injectorProgram
+struct INJECTORPROGRAM injectorProgram[injectorProgramCount] = {0}; //Initialize injector program pool to zero
+const struct INJECTORPROGRAM noInjectorProgramValues = {0}; // Program of valve fertigating without injectors
+#pragma idata i2cQueue
+struct I2CTRANSACTION i2cQueue[i2cQueueSize] = {0}; //Initialize I2C transaction queue to zero
+#pragma idata smsDelivery
+struct SMSDELIVERY smsDelivery[smsDeliveryCount] = {0}; //Initialize SMS delivery tracker to zero
+#pragma idata deliveryReportQueue
+struct DELIVERYREPORT deliveryReportQueue[deliveryReportQueueSize] = {0}; //Initialize delivery report queue to zero
 /************* statically allocated initialized user variables#end *******/
 
 /***************************** EEPROM Address definition#start ***********************/
@@ -214,6 +352,33 @@ const unsigned int eepromAddress[16] = {0x0000, 0x0030, 0x0060, 0x0090, 0x00C0,
 #define forSystem 15    // To store other system values
 /***************************** Macros for EEPROM Address location#end ****************/
 
+/***************************** Macros for Field valve EEPROM layout#start **************/
+// Byte offsets from EEPROM address of field valve, 16 bit values are stored lower byte first
+#define valveDryValueOffset 0               // To store dry value (2)
+#define valveWetValueOffset 2               // To store wet value (2)
+#define valveOnPeriodOffset 4               // To store valve on period (2)
+#define valveFertigationDelayOffset 6       // To store fertigation delay (2)
+#define valveFertigationOnPeriodOffset 8    // To store fertigation on period (2)
+#define valveInjectorOnPeriodOffset 10      // To store injector on period (2 x 4)
+#define valveInjectorOffPeriodOffset 18     // To store injector off period (2 x 4)
+#define valveInjectorCycleOffset 26         // To store injector cycle (1 x 4)
+#define valveOffPeriodOffset 30             // To store valve off period in days
+#define valveMotorOnHourOffset 31           // To store motor on time hour
+#define valveMotorOnMinuteOffset 32         // To store motor on time minute
+#define valveNextDueDDOffset 33             // To store next due day
+#define valveNextDueMMOffset 34             // To store next due month
+#define valveNextDueYYOffset 35             // To store next due year
+#define valveFertigationInstanceOffset 36   // To store remaining fertigation instances
+#define valvePriorityOffset 37              // To store valve priority
+#define valveFertigationStageOffset 38      // To store fertigation stage
+#define valveCyclesOffset 39                // To store cycles
+#define valveCyclesExecutedOffset 40        // To store cycles executed
+#define valveStatusOffset 41                // To store valve on/off status
+#define valveIsConfiguredOffset 42          // To store valve configuration status
+#define valveIsFertigationEnabledOffset 43  // To store fertigation enable status
+#define valveFertigationInterruptedOffset 44 // To store fertigation interrupted status
+/***************************** Macros for Field valve EEPROM layout#end ****************/
+
 /***************************** Macros for Fertigation stages #start ****************/
 #define wetPeriod 1   
 #define injectPeriod 2
@@ -263,6 +428,17 @@ unsigned int injector3OffPeriodCnt = CLEAR; // to store injector 3 on period cou
 unsigned int injector4OffPeriodCnt = CLEAR; // to store injector 4 on period count
 unsigned int noLoadCutOff = CLEAR;
 unsigned int fullLoadCutOff = CLEAR;
+unsigned int motorCurrentRMS = CLEAR; // To store RMS value of CT output calculated over last sampling window
+unsigned int analogValue[4] = {0}; // To store latest value of analog channels -- filtered RMS of CT, average of wind speed, temperature and RTC battery
+unsigned int motorCurrentAccumulator = CLEAR; // To store 4 times of filtered RMS value for low pass filter
+unsigned long ctSquareSum = CLEAR; // To store sum of squares of CT samples in current sampling window
+unsigned long ctSampleSum = CLEAR; // To store sum of CT samples in current sampling window, its mean is DC offset of CT output
+unsigned int moisturePeriod = CLEAR; // To store averaged cycle width of moisture sensor in Timer1 counts
+unsigned int fieldMoisturePeriod[12] = {0}; // To store last measured cycle width of each field sensor
+unsigned int fieldMoistureMeasured = CLEAR; // To indicate field moisture level is measured, bit0 for field 1 .. bit11 for field 12
+unsigned int fieldMoistureFailed = CLEAR; // To indicate field moisture sensor failed in last measurement, bit0 for field 1 .. bit11 for field 12
+unsigned int fieldMoistureDay[12] = {0}; // To store day number of date on which moisture level of each field is measured
+unsigned int fieldMoistureMinute[12] = {0}; // To store minute of day at which moisture level of each field is measured
 unsigned char fieldList[12] = {'\0'}; // To store valve list to be executed simultaneous
 unsigned char lastFieldList[12] = {'\0'}; // To store valve list to be switched off after execution simultaneous
 unsigned char userMobileNo[11] = ""; // To store 10 byte user mobile no.
@@ -288,13 +464,14 @@ unsigned char resetCount = CLEAR; // To store count of reset occurred by MCLR Re
 //unsigned char startFieldNo = 0;  // To indicate starting field irrigation valve no. for scanning
 unsigned char space = 0x20; // Represents space Ascii
 unsigned char terminateSms = 0x1A; // Represents Ctrl+z to indicate end of SMS
+unsigned char escapeSms = 0x1B; // Represents Esc to abort SMS text entry
 unsigned char enter = 0x0D; // Represents Enter Key ASCII
 unsigned char newLine = 0x0A; // Represents New Line Key ASCII
 unsigned char hundredsDigit = CLEAR; // To store hundred's digit no. "1XX"
 unsigned char tensDigit = CLEAR; // To store ten's digit no. "X1X"
 unsigned char unitsDigit = CLEAR; // To store unit's digit no. "XX1"
 unsigned char Timer0Overflow = CLEAR; // To store timer0 overflow count
-unsigned char Timer1Overflow = CLEAR; // To store timer1 overflow count
+volatile unsigned char Timer1Overflow = CLEAR; // To store timer1 overflow count
 unsigned char Timer3Overflow = CLEAR; // To store timer1 overflow count
 unsigned char filtrationCycleSequence = CLEAR; // To store filtration  cycle sequence
 unsigned char currentYY = CLEAR; // To store extracted year from received date from GSM in YYYY format
@@ -303,6 +480,12 @@ unsigned char currentDD = CLEAR; // To store extracted day from received date fr
 unsigned char currentHour = CLEAR; // To store extracted hour time from received date from GSM in hr format
 unsigned char currentMinutes = CLEAR; // To store extracted minutes time from received date from GSM in mm format
 unsigned char currentSeconds = CLEAR; // To store extracted seconds time from received date from GSM in mm format
+unsigned char clockSeconds = CLEAR; // To store seconds of system clock maintained in RAM
+unsigned char clockMinutes = CLEAR; // To store minutes of system clock maintained in RAM
+unsigned char clockHour = CLEAR; // To store hour of system clock maintained in RAM
+unsigned char clockDD = CLEAR; // To store day of system clock maintained in RAM
+unsigned char clockMM = CLEAR; // To store month of system clock maintained in RAM
+unsigned char clockYY = CLEAR; // To store year of system clock maintained in RAM
 unsigned char dueYY = CLEAR; // To store calculated due year in YYYY format
 unsigned char dueMM = CLEAR; // To store calculated due month in MM format
 unsigned char filtrationDelay1 = CLEAR; // To store filtration Delay1 in minutes
@@ -310,21 +493,204 @@ unsigned char filtrationDelay2 = CLEAR; // To store filtration Delay2 in minutes
 unsigned char filtrationDelay3 = CLEAR; // To store filtration Delay3 in minutes
 unsigned char filtrationOnTime = CLEAR; // To store filtration OnTime in minutes
 unsigned char dryRunCheckCount = CLEAR; // To store dry run check count
+unsigned char ctSampleCount = CLEAR; // To store no. of CT samples in current sampling window
+unsigned char i2cQueueHead = CLEAR; // To store index of I2C transaction in progress
+unsigned char i2cQueueTail = CLEAR; // To store index of next free I2C transaction
+unsigned char i2cQueueCount = CLEAR; // To store no. of queued I2C transactions
+unsigned char i2cState = CLEAR; // To store state of I2C transaction in progress
+unsigned char i2cIndex = CLEAR; // To store index of byte being transferred in I2C transaction
+unsigned char rtcRegister[7] = {0}; // To store DS1307 time and date registers in BCD format
+unsigned char analogScanChannel = CLEAR; // To store analog channel being converted in background scan
+unsigned char analogLastChannel = CLEAR; // To store last analog channel to be converted in background scan
+unsigned char analogScanCount = CLEAR; // To store no. of background scans since last RTC battery measurement
+unsigned char phaseStatus = CLEAR; // To store debounced status of lost phases, bit0 for R, bit1 for Y and bit2 for B
+unsigned char moistureScanFieldNo = CLEAR; // To store next field no. for background moisture sensor scan
+unsigned char smsDeliveryNext = CLEAR; // To store slot of SMS delivery tracker to be used for next SMS
+unsigned char deliveryReportIndex = CLEAR; // To store position in +CDS delivery report being received
+unsigned char deliveryReportField = CLEAR; // To store field no. of +CDS delivery report being received
+unsigned char deliveryReportReference = CLEAR; // To store message reference of received delivery report
+unsigned char deliveryReportStatus = CLEAR; // To store delivery status of received delivery report
+volatile unsigned char deliveryReportHead = CLEAR; // To store slot of delivery report queue to be filled by RX interrupt
+volatile unsigned char deliveryReportTail = CLEAR; // To store slot of delivery report queue to be matched next
+unsigned char deliveryReportOctet = CLEAR; // To store index of octet being received in +CDS delivery report PDU
+unsigned char deliveryReportNextOctet = CLEAR; // To store index of next octet to be read from +CDS delivery report PDU
+unsigned char deliveryReportValue = CLEAR; // To store octet being received in +CDS delivery report PDU
 unsigned char nxtPriority = 1; // To store next priority for due valve by default set to first priority
 /***** System Config definition#end *************************/
 
-/******Data Encryption and Decryption#start *****************/
+/******Message arena#start *****************/
+/*
+ * Message buffers share single arena as per phase of SMS handling in which they are used
+ * Receive : gsmResponse                    -- AT command response and received SMS
+ * Decode  : stringToDecode, decodedString  -- SMS text is moved to start of gsmResponse and decoded into decodedString
+ * Parse   : decodedString, gsmResponse     -- command is parsed while responses of commands to GSM are received
+ * Reply   : decodedString, gsmResponse, stringToEncode, encodedString -- reply is encoded in unused tail of decodedString and gsmResponse
+ * Send    : gsmResponse, smsReply        -- reply is composed in tail of gsmResponse while response of AT+CMGS is received at its start
+ */
+#define smsTextSize 160 // Max length of SMS text
+#define decodedTextSize ((smsTextSize / 4) * 3) // Max length of base64 decoded SMS text
+#define gsmResponseSize 220
+#define decodedStringSize 220
+#define messageArenaSize (gsmResponseSize + decodedStringSize)
+#define encodedStringOffset 120 // Tail of gsmResponse, response of AT+CMGS is short
+#define encodedStringSize 100
+#define stringToEncodeOffset (gsmResponseSize + decodedTextSize + 1) // Tail of decodedString beyond decoded text
+#define stringToEncodeSize 72 // Base64 encoding of 72 bytes fits in encodedString
+#define smsReplyOffset (gsmResponseSize - smsTextSize) // Tail of gsmResponse, response of AT+CMGS is short
+// Compile time check of arena -- array of negative size is reported if any phase does not fit in arena
+typedef char messageArenaReceiveCheck[(gsmResponseSize <= messageArenaSize) ? 1 : -1];
+typedef char messageArenaDecodeCheck[(smsTextSize <= gsmResponseSize && gsmResponseSize + decodedTextSize + 1 <= messageArenaSize) ? 1 : -1];
+typedef char messageArenaReplyCheck[(encodedStringOffset + encodedStringSize <= gsmResponseSize && (stringToEncodeSize / 3) * 4 + 4 <= encodedStringSize && stringToEncodeOffset + stringToEncodeSize <= messageArenaSize) ? 1 : -1];
+typedef char messageArenaSendCheck[(smsReplyOffset >= 20) ? 1 : -1];
+
+#pragma idata messageArena
+unsigned char messageArena[messageArenaSize] = "HELLO"; // To store the received message from GSM, its decoded text and reply
+#define gsmResponse (messageArena) // To store the received message from GSM -- message can be command response or SMS
+#define decodedString (messageArena + gsmResponseSize) // To store decoded SMS text
+struct MESSAGEBUFFER gsmResponseBuffer = {gsmResponse, 0, gsmResponseSize}; // To track length of received response up to OK
+struct MESSAGEBUFFER decodedStringBuffer = {decodedString, 0, decodedStringSize}; // To track length of decoded message
+#define smsReply (messageArena + smsReplyOffset) // To store composed SMS text to be sent
+struct MESSAGEBUFFER smsReplyBuffer = {smsReply, 0, smsTextSize}; // To track length of composed SMS text
 #ifdef Encryption_ON_H
-#pragma idata encodedString 
-unsigned char encodedString[100] = {'\0'};
-#pragma idata stringToEncode
-unsigned char stringToEncode[100] = {'\0'};
-#pragma idata stringToDecode
-unsigned char stringToDecode[220] = {'\0'};
+#define stringToDecode (messageArena) // To store SMS text moved in place to start of gsmResponse
+#define encodedString (messageArena + encodedStringOffset) // To store encoded reply
+#define stringToEncode (messageArena + stringToEncodeOffset) // To store reply to be encoded
+struct MESSAGEBUFFER stringToDecodeBuffer = {stringToDecode, 0, gsmResponseSize}; // To track length of message to be decoded
 #endif
-#pragma idata decodedString
-unsigned char decodedString[220] = {'\0'};
-/***** Data Encryption and Decryption#end *********************/
+/***** Message arena#end *********************/
+
+/***** Received SMS definition#start *****/
+#define receivedSmsIgnored 0 // SMS is not read or not from no. with country code
+#define receivedSmsText 1 // SMS text is moved to start of gsmResponse
+#define receivedSmsBinary 2 // Binary frame of 8 bit SMS is copied into decodedString
+/***** Received SMS definition#end *******/
+
+/***** SMS notification queue definition#start *****/
+/*
+ * Notifications to user raised within one control step are rendered into queue and sent as one SMS when they fit.
+ * Each notification is stored with trailing separator, separator of last notification is not sent.
+ * Alarms are inserted after queued alarms and ahead of acknowledgements.
+ */
+#define smsAcknowledgement 0 // Notification about completed action, alarms are given by alert type
+#define smsQueueSeparator "\r\n" // To separate notifications in one SMS
+#define smsQueueSeparatorSize 2
+unsigned char smsQueueText[smsTextSize + smsQueueSeparatorSize]; // To store rendered notifications to be sent
+struct MESSAGEBUFFER smsQueueBuffer = {smsQueueText, 0, smsTextSize + smsQueueSeparatorSize}; // To track length of queued notifications
+unsigned char smsQueueAlarmLength = CLEAR; // To store length of alarms at start of queue
+/***** SMS notification queue definition#end *******/
+
+/***** Concatenated SMS definition#start *****/
+/*
+ * Reply longer than one SMS is rendered again for each part, only window of current part is kept in smsReply.
+ * Each part is sent in PDU mode with 6 octet concatenation header, leaving 153 septets for text.
+ */
+#define smsConcatTextSize 153 // Max length of text in each part of concatenated SMS
+#define smsConcatMaxParts 4 // Reply is truncated after this no. of parts
+#define smsPduHeaderSize 12 // Octets of SMS-SUBMIT PDU before user data, service centre excluded
+#ifdef SMS_DELIVERY_REPORT_ON_H
+#define smsSubmitFirstOctet 0x21 // SMS-SUBMIT with status report request
+#else
+#define smsSubmitFirstOctet 0x01 // SMS-SUBMIT
+#endif
+#define smsUserDataHeaderIndicator 0x40 // Set in first octet of SMS-SUBMIT having user data header
+unsigned int smsReplyPosition = CLEAR; // To store no. of characters rendered for reply being composed
+unsigned int smsReplyWindowStart = CLEAR; // To store position of first character of reply kept in smsReply
+unsigned char smsConcatReference = CLEAR; // To store reference no. shared by parts of concatenated SMS
+/***** Concatenated SMS definition#end *******/
+
+/***** Binary SMS frame definition#start *****/
+/*
+ * Binary frame is carried as 8 bit user data of SMS in PDU mode, its first byte is frame type.
+ * Reply frame type is request frame type with MSB set.
+ * Status request : type                                                   -- reply : type, valve status bits as in STATUS report
+ * Set request    : type, one or more records of binaryValveRecordSize    -- reply : type, no. of records applied
+ * Valve record   : priority, ON period(2), OFF period, motor on hour, motor on minute, dry value(2), wet value(2),
+ *                  cycles, day count, field mask(2) with field 1 at bit 11 -- 16 bit values are sent MSB first
+ */
+#define binaryStatusFrame 0x01 // To get status of all configured valves
+#define binarySetFrame 0x02 // To configure valves of one or more priorities
+#define binaryReplyFrame 0x80 // Set in frame type of reply
+#define binaryUnknownFrame 0xFF // Reply to unknown frame type
+#define binaryValveRecordSize 14
+#define binaryFrameSize 140 // Max length of 8 bit user data of SMS
+/***** Binary SMS frame definition#end *******/
+
+/***** Bulk valve configuration definition#start *****/
+/*
+ * Several SET blocks of different priorities can be sent in one SMS separated by bulkBlockSeparator,
+ * e.g. SET01 11 1 10 10 0 300 0001 3 0;SET02 11 1 10 40 0 300 0203 3 0
+ * Valves of all blocks are updated in RAM first and committed into EEPROM in one batch, then one acknowledgement is sent.
+ */
+#define bulkBlockSeparator ';' // Separates priority blocks of bulk configuration
+unsigned int valveCommitMask = CLEAR; // To store fields whose configuration is pending to be committed into EEPROM, field 1 at bit 0
+/***** Bulk valve configuration definition#end *******/
+
+/***** Configuration snapshot definition#start *****/
+/*
+ * Snapshot image : version, length(2), configured field mask(2) with field 1 at bit 11,
+ *                  valve record of each configured field, filtration record, motor load record, CRC-16(2)
+ * Valve record   : priority with fertigation enabled at MSB, ON period(2), OFF period, motor on hour, motor on minute,
+ *                  dry value(2), wet value(2), cycles, cycles executed, due DD, due MM, due YY
+ *                  followed for fertigation enabled valve by fertigation delay(2), ON period(2), iterations,
+ *                  injector ON periods(2 x 4), OFF periods(2 x 4) and cycles(4)
+ * Filtration     : delay 1, delay 2, delay 3, ON time, separation time(2), enabled
+ * Motor load     : no load cut-off(2), full load cut-off(2)
+ * 16 bit values are sent MSB first, CRC-16/CCITT (poly 0x1021, initial 0xFFFF) covers all bytes before it.
+ * Image is sent as base64 in parts of snapshotPartSize bytes, each part on its own line "RESTORE<part no.><Space><base64>"
+ * to be sent back in its own SMS. Image is applied only when all parts are received in order and CRC matches.
+ */
+#define snapshotVersion 1
+#define snapshotHeaderSize 5
+#define snapshotValveRecordSize 15
+#define snapshotFertigationRecordSize 25
+#define snapshotSystemRecordSize 11 // Filtration and motor load record
+#define snapshotCrcSize 2
+#define snapshotImageSize 320
+#define snapshotPartSize 72 // Bytes of image per RESTORE part i.e. 96 base64 characters
+// Reply listing all RESTORE parts of largest image must fit in concatenated SMS
+typedef char snapshotReplyCheck[((snapshotImageSize + snapshotPartSize - 1) / snapshotPartSize) * 12 + ((snapshotImageSize + 2) / 3) * 4 <= smsConcatTextSize * smsConcatMaxParts ? 1 : -1];
+unsigned char snapshotImage[snapshotImageSize]; // To store configuration image being exported or received for restore
+unsigned int snapshotLength = CLEAR; // To store no. of bytes of configuration image built or received
+unsigned char snapshotPart = CLEAR; // To store no. of last RESTORE part received
+/***** Configuration snapshot definition#end *******/
+
+/***** Schedule plan definition#start *****/
+/*
+ * PLAN simulates schedule of copied valve table forward from current time and replies one line per valve action :
+ * <DD>/<MM><Space><HH>:<MM><Space><ON period>[F]<Space><field no. list>, F marks action started with fertigation.
+ */
+#define planEventCount 12 // Max valve actions listed in PLAN reply
+struct PLANVALVE planValve[12]; // To store copy of valve table simulated by PLAN
+struct PLANEVENT planEvent[planEventCount]; // To store valve actions listed by PLAN
+unsigned char planEventTotal = CLEAR; // To store no. of valve actions listed by PLAN
+unsigned int planStartDay = CLEAR; // To store day number of day on which plan starts
+/***** Schedule plan definition#end *******/
+
+/***** Alert suppression definition#start *****/
+/*
+ * Only first alarm of each alert type is sent within window, repeated alarms are counted
+ * and folded into one summary of occurrences when window is over.
+ */
+#define alertPhaseFailure 1 // Phase failure detected
+#define alertLowPhase 2 // Low phase current detected
+#define alertDryRun 3 // Motor dry run detected
+#define alertRtcBattery 4 // RTC battery found low
+#define alertMoistureSensor 5 // Moisture sensor failed
+#define alertTypeCount 5
+#define alertWindowMinutes 60 // Suppression window of each alert type in minutes
+struct ALERTWINDOW alertWindow[alertTypeCount] = {0}; // To track suppression window of each alert type
+unsigned char alertSummaryIndex = CLEAR; // To store alert window being reported in summary
+/***** Alert suppression definition#end *******/
+
+/***** Valve status report definition#start *****/
+/*
+ * Status report starts with 12 bit mask of configured fields, field 1 at MSB, followed by 48 bit record of each configured field.
+ * Record : priority 4, status 1, fertigation enabled 1, cycles remaining 4, ON period 10, OFF period 7,
+ *          due day 5, due month 4, motor on hour 5, motor on minute 6, reserved 1
+ * Bits are sent MSB first, 6 bits per base64 character, so each record takes 8 characters.
+ */
+#define valveStatusRecordBits 48
+/***** Valve status report definition#end *******/
 
 /***** SMS prototype definition#start *************************/
 unsigned static char admin[3] = "AU"; // To Administer device
@@ -336,6 +702,10 @@ unsigned static char active[7] = "ACTIVE"; // To ACTIVATE filtration valve
 unsigned static char dactive[8] = "DACTIVE"; // To De-Activate filtration valve
 unsigned static char hold[5] = "HOLD"; // To hold irrigation valve settings
 unsigned static char extract[8] = "EXTRACT"; // To extract diagnostic data
+unsigned static char status[7] = "STATUS"; // To get status of all configured valves
+unsigned static char backup[7] = "BACKUP"; // To export configuration snapshot
+unsigned static char restore[8] = "RESTORE"; // To restore configuration snapshot
+unsigned static char plan[5] = "PLAN"; // To preview valve actions of next days
 unsigned static char ok[3] = "ok"; // Acknowledge from GSM	
 unsigned static char time[5] = "TIME"; // To get current time from RTC
 unsigned static char feed[5] = "FEED"; // To Set current time into RTC
@@ -350,45 +720,98 @@ unsigned static char getfreq[8] = "GETFREQ"; // get ct values
 unsigned static char countryCode[4] = "+91"; //Country code for GSM
 /***** SMS prototype definition#end ***************************/
 
+/***** SMS phrase dictionary definition#start *************************/
+/*
+ * Phrases shared by SMS strings are stored once, SMS string refers to phrase by single code byte 0x80 onwards
+ * Phrase code is expanded while SMS text is rendered, SMS text itself is plain ASCII below 0x80
+ */
+#define smsPhraseCode 0x80 // Code of first phrase
+#define smsPhraseCount 16
+#define phraseIrrigation "\x80" // "Irrigation "
+#define phraseFertigation "\x81" // "Fertigation "
+#define phraseForField "\x82" // " for field "
+#define phraseForPriority "\x83" // " for priority "
+#define phraseSystemRestarted "\x84" // "System restarted "
+#define phraseIncompleteIrrigation "\x85" // " with incomplete Irrigation for field "
+#define phraseDryRun "\x86" // "Dry Run detected, Motor"
+#define phraseSwitchedOff "\x87" // "switched off.\r\n"
+#define phraseScheduled "\x88" // "scheduled to next d"
+#define phraseSuspending "\x89" // ", suspending all actions"
+#define phraseFailureDetected "\x8A" // " failure detected"
+#define phraseMoistureSensor "\x8B" // "Moisture sensor "
+#define phraseSuccessfully "\x8C" // " successfully"
+#define phraseLoginCode "\x8D" // "Login code "
+#define phraseSystemReset "\x8E" // "System reset occurred, "
+#define phraseNewRtcBattery "\x8F" // "New RTC battery found, "
+const char *const smsPhrase[smsPhraseCount] = {
+    "Irrigation ",
+    "Fertigation ",
+    " for field ",
+    " for priority ",
+    "System restarted ",
+    " with incomplete Irrigation for field ",
+    "Dry Run detected, Motor",
+    "switched off.\r\n",
+    "scheduled to next d",
+    ", suspending all actions",
+    " failure detected",
+    "Moisture sensor ",
+    " successfully",
+    "Login code ",
+    "System reset occurred, ",
+    "New RTC battery found, "
+};
+/***** SMS phrase dictionary definition#end ***************************/
+
 /***** SMS strings definition#start *************************/
-const char SmsAU1[23] = "Admin set successfully"; // Acknowledge user about successful Admin Registration
+const char SmsAU1[] = "Admin set" phraseSuccessfully; // Acknowledge user about successful Admin Registration
 const char SmsAU2[51] = "You are no more Admin now. New Admin is set to\r\n"; //To notify old Admin about new Admin.
 const char SmsAU3[22] = "Authentication failed"; // Acknowledge user about Authentication failed
-const char SmsAU4[64] = "System Authenticated with Phase failure, suspending all actions"; // Acknowledge user about System Authenticated with Phase failure
+const char SmsAU4[] = "System Authenticated with Phase failure" phraseSuspending; // Acknowledge user about System Authenticated with Phase failure
 
-const char SmsPwd1[32] = "Login code changed successfully"; // Acknowledge user about successful password update
-const char SmsPwd2[23] = "Login code not changed";
+const char SmsPwd1[] = phraseLoginCode "changed" phraseSuccessfully; // Acknowledge user about successful password update
+const char SmsPwd2[] = phraseLoginCode "not changed";
 const char SmsPwd3[23] = "Wrong login code found"; // Acknowledge user about successful motor off action
 
-const char SmsIrr1[36] = "Irrigation configured for priority "; // Acknowledge user about successful Irrigation configuration
-const char SmsIrr2[48] = "Irrigation configuration disabled for priority "; // Acknowledge user about successful Irrigation configuration disable action
-const char SmsIrr3[40] = "Irrigation not configured for priority "; // Acknowledge user about  Irrigation not configured
-const char SmsIrr4[30] = "Irrigation started for field "; // Acknowledge user about successful Irrigation started action
-const char SmsIrr5[30] = "Irrigation stopped for field "; // Acknowledge user about successful Irrigation stopped action
-const char SmsIrr6[57] = "Wet field detected.\r\nIrrigation not started for field "; // Acknowledge user about Irrigation not started due to wet field detection
-const char SmsIrr7[15] = "Irrigation No:"; // Send diagnostic data for irrigation
-
-const char SmsFert1[64] = "Irrigation is not Active. Fertigation not enabled for priority "; // Acknowledge user about Fertigation not configured due to disabled irrigation
-const char SmsFert2[56] = "Incorrect values. Fertigation not enabled for priority "; // Acknowledge user about Fertigation not configured due to incorrect values
-const char SmsFert3[34] = "Fertigation enabled for priority "; // Acknowledge user about successful Fertigation enabled action
-const char SmsFert4[35] = "Fertigation disabled for priority "; // Acknowledge user about successful Fertigation disabled action
-const char SmsFert5[31] = "Fertigation started for field "; // Acknowledge user about successful Fertigation started action
-const char SmsFert6[31] = "Fertigation stopped for field "; // Acknowledge user about successful Fertigation stopped action
-const char SmsFert7[68] = "Fertigation stopped with fertilizer level sensor failure for field "; // Acknowledge user about Fertigation stopped action with sensor failure
-const char SmsFert8[57] = "Fertigation stopped with low fertilizer level for field "; // Acknowledge user about Fertigation stopped action with low fertilizer level 
+const char SmsIrr1[] = phraseIrrigation "configured" phraseForPriority; // Acknowledge user about successful Irrigation configuration
+const char SmsIrr2[] = phraseIrrigation "configuration disabled" phraseForPriority; // Acknowledge user about successful Irrigation configuration disable action
+const char SmsIrr3[] = phraseIrrigation "not configured" phraseForPriority; // Acknowledge user about  Irrigation not configured
+const char SmsIrr4[] = phraseIrrigation "started" phraseForField; // Acknowledge user about successful Irrigation started action
+const char SmsIrr5[] = phraseIrrigation "stopped" phraseForField; // Acknowledge user about successful Irrigation stopped action
+const char SmsIrr6[] = "Wet field detected.\r\n" phraseIrrigation "not started" phraseForField; // Acknowledge user about Irrigation not started due to wet field detection
+const char SmsIrr7[] = phraseIrrigation "No:"; // Send diagnostic data for irrigation
+const char SmsIrr8[] = "Status:{V}"; // Send status of all configured irrigation valves
+const char SmsIrr9[] = phraseIrrigation "configured for {n} priorities"; // Acknowledge user about successful bulk Irrigation configuration
+
+const char SmsCfg1[] = "{C}"; // Send configuration snapshot as RESTORE parts
+const char SmsCfg2[] = "Configuration restored" phraseSuccessfully; // Acknowledge user about successful configuration restore
+const char SmsCfg3[] = "Configuration restore failed"; // Acknowledge user about invalid or out of order RESTORE part
+const char SmsCfg4[] = "Configuration too large for backup"; // Acknowledge user about configuration snapshot not built
+const char SmsCfg5[] = phraseIrrigation "is active, configuration not restored"; // Acknowledge user about Irrigation is active, RESTORE not accepted
+
+const char SmsPlan1[] = "Plan for {n} days:{P}"; // Send valve actions of next days simulated from current schedule
+
+const char SmsFert1[] = phraseIrrigation "is not Active. " phraseFertigation "not enabled" phraseForPriority; // Acknowledge user about Fertigation not configured due to disabled irrigation
+const char SmsFert2[] = "Incorrect values. " phraseFertigation "not enabled" phraseForPriority; // Acknowledge user about Fertigation not configured due to incorrect values
+const char SmsFert3[] = phraseFertigation "enabled" phraseForPriority; // Acknowledge user about successful Fertigation enabled action
+const char SmsFert4[] = phraseFertigation "disabled" phraseForPriority; // Acknowledge user about successful Fertigation disabled action
+const char SmsFert5[] = phraseFertigation "started" phraseForField; // Acknowledge user about successful Fertigation started action
+const char SmsFert6[] = phraseFertigation "stopped" phraseForField; // Acknowledge user about successful Fertigation stopped action
+const char SmsFert7[] = phraseFertigation "stopped with fertilizer level sensor failure" phraseForField; // Acknowledge user about Fertigation stopped action with sensor failure
+const char SmsFert8[] = phraseFertigation "stopped with low fertilizer level" phraseForField; // Acknowledge user about Fertigation stopped action with low fertilizer level 
 
 const char SmsFilt1[27] = "Water filtration activated";
 const char SmsFilt2[29] = "Water filtration deactivated"; 
 const char SmsFilt3[32] = "Water Filtration is not enabled";
 const char SmsFilt4[27] = "Water Filtration Sequence:";
 
-const char SmsSR01[60] = "System restarted with phase failure, suspending all actions"; // Acknowledge user about system restarted with Valve action
-const char SmsSR02[75] = "System restarted for Power Interrupt with incomplete Irrigation for field "; // Acknowledge user about system restarted with Valve action
-const char SmsSR03[72] = "System restarted for Low Power In with incomplete Irrigation for field "; // Acknowledge user about system restarted with Valve action
-const char SmsSR04[74] = "System restarted in Diagnostic Mode with incomplete Irrigation for field "; // Acknowledge user about system restarted with Valve action
-const char SmsSR05[79] = "System restarted for All Phase Detection with incomplete Irrigation for field "; // Acknowledge user about system restarted with Valve action
-const char SmsSR06[71] = "System restarted for WDT Timeout with incomplete Irrigation for field "; // Acknowledge user about system restarted with Valve action
-const char SmsSR07[71] = "System restarted for Stack Error with incomplete Irrigation for field "; // Acknowledge user about system restarted with Valve action
+const char SmsSR01[] = phraseSystemRestarted "with phase failure" phraseSuspending; // Acknowledge user about system restarted with Valve action
+const char SmsSR02[] = phraseSystemRestarted "for Power Interrupt" phraseIncompleteIrrigation; // Acknowledge user about system restarted with Valve action
+const char SmsSR03[] = phraseSystemRestarted "for Low Power In" phraseIncompleteIrrigation; // Acknowledge user about system restarted with Valve action
+const char SmsSR04[] = phraseSystemRestarted "in Diagnostic Mode" phraseIncompleteIrrigation; // Acknowledge user about system restarted with Valve action
+const char SmsSR05[] = phraseSystemRestarted "for All Phase Detection" phraseIncompleteIrrigation; // Acknowledge user about system restarted with Valve action
+const char SmsSR06[] = phraseSystemRestarted "for WDT Timeout" phraseIncompleteIrrigation; // Acknowledge user about system restarted with Valve action
+const char SmsSR07[] = phraseSystemRestarted "for Stack Error" phraseIncompleteIrrigation; // Acknowledge user about system restarted with Valve action
 /* //disabled SMS for reset on NO valve in action to reduce SMS count
 const char SmsSR08[37] = "System restarted for Power Interrupt"; // Acknowledge user about system restarted with No Valve action
 const char SmsSR09[31] = "System restarted for Low Power"; // Acknowledge user about system restarted with No Valve action
@@ -397,18 +820,18 @@ const char SmsSR11[41] = "System restarted for All Phase Detection"; // Acknowle
 const char SmsSR12[33] = "System restarted for WDT timeout"; // Acknowledge user about system restarted with No Valve action
 const char SmsSR13[33] = "System restarted for stack error"; // Acknowledge user about system restarted with No Valve action
 */
-const char SmsSR14[59] = "System reset occurred, login code reset to Factory setting"; // Acknowledge user about successful motor off action
-const char SmsSR15[50] = "System reset occurred, Irrigation setting deleted"; // Acknowledge user about successful motor off action
+const char SmsSR14[] = phraseSystemReset "login code reset to Factory setting"; // Acknowledge user about successful motor off action
+const char SmsSR15[] = phraseSystemReset phraseIrrigation "setting deleted"; // Acknowledge user about successful motor off action
 
 const char SmsRTC1[50] = "RTC Battery found low, please replace RTC battery"; // Acknowledge user about replace RTC battery
 const char SmsRTC2[41] = "System time synced to current local time"; 
-const char SmsRTC3[56] = "New RTC battery found, system time is set to local time";
-const char SmsRTC4[56] = "New RTC battery found, please sync system time manually"; // Acknowledge user about setting RTC through Mobile App
+const char SmsRTC3[] = phraseNewRtcBattery "system time is set to local time";
+const char SmsRTC4[] = phraseNewRtcBattery "please sync system time manually"; // Acknowledge user about setting RTC through Mobile App
 
-const char SmsDR1[130] = "Dry Run detected, Motor, Irrigation and Fertigation switched off.\r\nIrrigation scheduled to next day with fertigation for field "; // Acknowledge user about successful motor off action
-const char SmsDR2[117] = "Dry Run detected, Motor and Irrigation switched off.\r\nIrrigation scheduled to next day with fertigation for field "; // Acknowledge user about successful motor off action
-const char SmsDR3[100] = "Dry Run detected, Motor and Irrigation switched off.\r\nIrrigation scheduled to next day for field "; // Acknowledge user about successful motor off action
-const char SmsDR4[105] = "Dry Run detected, Motor and Irrigation switched off.\r\nIrrigation scheduled to next due date for field "; // Acknowledge user about successful motor off action
+const char SmsDR1[] = phraseDryRun ", " phraseIrrigation "and " phraseFertigation phraseSwitchedOff phraseIrrigation phraseScheduled "ay with fertigation" phraseForField; // Acknowledge user about successful motor off action
+const char SmsDR2[] = phraseDryRun " and " phraseIrrigation phraseSwitchedOff phraseIrrigation phraseScheduled "ay with fertigation" phraseForField; // Acknowledge user about successful motor off action
+const char SmsDR3[] = phraseDryRun " and " phraseIrrigation phraseSwitchedOff phraseIrrigation phraseScheduled "ay" phraseForField; // Acknowledge user about successful motor off action
+const char SmsDR4[] = phraseDryRun " and " phraseIrrigation phraseSwitchedOff phraseIrrigation phraseScheduled "ue date" phraseForField; // Acknowledge user about successful motor off action
 
 const char SmsT1[27] = "Incorrect local time found"; 
 const char SmsT2[15] = "Current Time: ";
@@ -416,10 +839,11 @@ const char SmsT2[15] = "Current Time: ";
 const char SmsT3[2] = "-";
 /***********Debug**********/
 
-const char SmsMotor1[58] = "Irrigation completed for due fields\r\nMotor switched off"; // Acknowledge user about successful motor off action
-const char SmsMotor2[35] = "Motorload cut-off set successfully"; // Acknowledge user about successful motor off action
+const char SmsMotor1[] = phraseIrrigation "completed for due fields\r\nMotor switched off"; // Acknowledge user about successful motor off action
+const char SmsMotor2[] = "Motorload cut-off set" phraseSuccessfully; // Acknowledge user about successful motor off action
 const char SmsMotor3[47] = "NoLoad and FullLoad Motor thresholds set to : "; // Acknowledge user about motor load values
-const char SmsMotor4[49] = "Irrigation is active, Motor load cut-off not set"; // Acknowledge user about Irrigation is active, Motor load cut-off procedure not started
+const char SmsMotor4[] = phraseIrrigation "is active, Motor load cut-off not set"; // Acknowledge user about Irrigation is active, Motor load cut-off procedure not started
+const char SmsMotor5[] = "Motor current scale changed, Motor load cut-off cleared, please set again"; // Acknowledge user about motor load cut-off to be calibrated again
 
 const char SmsConnect[17] = "System Connected"; // Acknowledge user about successful connection
 
@@ -428,58 +852,146 @@ const char SmsTest[19] = "Test Data Injected";
 const char SmsKey1[15] = "Factory Key : "; // Factory key details
 const char SmsKey2[15] = "Current Key : "; // Current key details
 
-const char SmsPh1[47] = "Phase failure detected, suspending all actions"; // Acknowledge user about Phase failure status
+const char SmsPh1[] = "Phase" phraseFailureDetected phraseSuspending; // Acknowledge user about Phase failure status
 const char SmsPh2[69] = "Low Phase current detected, actions suspended, please restart system"; // Acknowledge user about successful motor off action
-const char SmsPh3[25] = "Phase R failure detected"; // Acknowledge user about phase failure status
-const char SmsPh4[25] = "Phase Y failure detected"; // Acknowledge user about phase failure status
-const char SmsPh5[25] = "Phase B failure detected"; // Acknowledge user about phase failure status
+const char SmsPh3[] = "Phase R" phraseFailureDetected; // Acknowledge user about phase failure status
+const char SmsPh4[] = "Phase Y" phraseFailureDetected; // Acknowledge user about phase failure status
+const char SmsPh5[] = "Phase B" phraseFailureDetected; // Acknowledge user about phase failure status
 const char SmsPh6[19] = "All Phase detected"; // Acknowledge user about phase status
+const char SmsPh7[] = "Phase R" phraseFailureDetected phraseSuspending; // Acknowledge user about Phase R failure status
+const char SmsPh8[] = "Phase Y" phraseFailureDetected phraseSuspending; // Acknowledge user about Phase Y failure status
+const char SmsPh9[] = "Phase B" phraseFailureDetected phraseSuspending; // Acknowledge user about Phase B failure status
 
-const char SmsMS1[57] = "Moisture sensor is failed, Irrigation started for field "; // Acknowledge user about failure in moisture sensor
-const char SmsMS2[43] = "Moisture sensor frequency value for field "; // Acknowledge user measured moisture sensor value
-const char SmsMS3[37] = "Moisture sensor is failed for field "; // Acknowledge user about failure in moisture sensor
+const char SmsMS1[] = phraseMoistureSensor "is failed, " phraseIrrigation "started" phraseForField; // Acknowledge user about failure in moisture sensor
+const char SmsMS2[] = phraseMoistureSensor "frequency value" phraseForField; // Acknowledge user measured moisture sensor value
+const char SmsMS3[] = phraseMoistureSensor "is failed" phraseForField; // Acknowledge user about failure in moisture sensor
 /***** SMS string definition#end ***************************/
 
-/***** statically allocated initialized user variables#start **/
-#pragma idata gsmResponse 
-unsigned char gsmResponse[220] = "HELLO"; // To store the received message from GSM -- message can be command response or SMS
-/***** statically allocated initialized user variables#end ****/
+/***** SMS template definition#start *************************/
+/*
+ * SMS text is rendered from templates, a placeholder {x} is replaced by controller state bound to key x
+ * n : field no. in temporaryBytesArray          a : new Admin mobile no. in temporaryBytesArray
+ * t : date time stamp in temporaryBytesArray    s : factory password        p : current password
+ * L : no load cut-off         H : full load cut-off         m : moisture sensor frequency
+ * o, f, d, w : ON period, OFF period, Dry value and Wet value of fieldValve[iterator]
+ * D : due date and motor on time of fieldValve[iterator]    G : continue with fertigation data of fieldValve[iterator]
+ * e, r, i : fertigation delay, ON period and iterations of fieldValve[iterator]
+ * 1, 2, 3, O, S : filtration delays, ON time and separation time
+ * F : field list      A : field list to activate      I : field list to deactivate
+ * N : occurrences of alert in window        h : start time of alert window
+ * V : status of all configured valves packed in base64 characters, see appendValveStatusToReply()
+ */
+#define smsInfoTemplateCount 13
+const char *const smsInfoTemplate[smsInfoTemplateCount] = {
+    "",                                                         // noInfo
+    "{a}",                                                      // newAdmin
+    "{n}",                                                      // fieldNoRequired
+    "{t}",                                                      // timeRequired
+    "{s}",                                                      // secretCodeRequired
+    "{L} and {H}",                                              // motorLoadRequired
+    "{n} is {m}",                                               // frequencyRequired
+    "{n} ONprd:{o} OFFprd:{f} Dry:{d} Wet:{w} DueDate: {D}\r\n{G}", // IrrigationData
+    "\r\nDelay1: {1}(Min) Delay2: {2}(Min) Delay3: {3}(Min)\r\nONTime: {O}(Min) Separation Time: {S}(Min)", // filtrationData
+    "{A}",                                                      // commonActiveFieldNoRequired
+    "{I}",                                                      // commonInActiveFieldNoRequired
+    "{F}",                                                      // fieldListRequired
+    "{p}"                                                       // secretCode1Required
+};
+const char SmsFertData1[] = phraseFertigation "enabled with delay:{e} ONprd:{r} Iteration:{i}\r\n"; // Fertigation data of irrigation valve
+const char SmsFertData2[] = phraseFertigation "not configured\r\n"; // Fertigation data of irrigation valve without fertigation
+const char *const alertSummaryTemplate[alertTypeCount] = {
+    "Phase failure: {N} occurrences since {h}",                 // alertPhaseFailure
+    "Low Phase current: {N} occurrences since {h}",             // alertLowPhase
+    "Dry run: {N} occurrences since {h}",                       // alertDryRun
+    "RTC Battery low: {N} occurrences since {h}",               // alertRtcBattery
+    phraseMoistureSensor "failure: {N} occurrences since {h}"   // alertMoistureSensor
+};
+/***** SMS template definition#end ***************************/
 
 /***** statically allocated initialized user variables#start **/
 #pragma idata cmti
 unsigned char static cmti[14] = "+CMTI: \"SM\",x"; // This cmd is received from GSM to Notify New SMS at 1st SIM memory
+unsigned char static cds[7] = "+CDS: "; // This cmd is received from GSM to report delivery status of sent SMS
 /***** statically allocated initialized user variables#end ****/
 /************* Strings definition#end ************************************/
 
 /************* Booleans definition#start *********************************/ 
-_Bool systemAuthenticated = false;              // To check if system is initialized by user for first time.
 _Bool newSMSRcvd = false;                       // To check if communication is first initialized by GSM. 
 _Bool checkMoistureSensor = false;              // To check status of Moisture sensor
 _Bool moistureSensorFailed = false;             // status of Moisture sensor
 _Bool controllerCommandExecuted = false;        // To check response to system cmd.
-_Bool currentDateCalled = false;                // To avoid repetitive fetching of date through GSM
-_Bool sleepCountChangedDueToInterrupt = false;  // TO check if sleep count need to calculate again if change due to GSM interrupt
+volatile _Bool smsPromptReceived = false;       // To indicate '>' prompt of GSM to enter SMS text
+_Bool smsPduReception = false;                  // To indicate SMS is being read in PDU mode
+_Bool smsPduDataStarted = false;                // To indicate hexadecimal PDU of SMS being read is started
+_Bool smsPduNibblePending = false;              // To indicate high nibble of PDU octet is received
 _Bool inSleepMode = false;                      // To check if system is in sleep mode
-_Bool dryRunDetected = false;                   // To state water level of tank --true for Low and --false for Full
-_Bool lowPhaseCurrentDetected = false;          // To state motor not started due to low phase current
-_Bool valveDue = false;                         // To indicate if any valve is due for operation after checking
-_Bool valveExecuted = false;                    // To indicate if valve executed
-_Bool onHold = false;                           // To indicate Field valve hold status
-_Bool dueValveChecked = false;					// To indicate valve due is checked at latest 
-_Bool correctDate = false;          			// To indicate received date is correct
 _Bool phaseFailureDetected = false;             // To indicate phase failure
-_Bool lowRTCBatteryDetected = false;            // To store RTC Battery level Status
-_Bool rtcBatteryLevelChecked = false;           // To indicate condition to check RTC battery level
 _Bool phaseFailureActionTaken = false;          // To indicate action taken after phase failure detection
-_Bool filtrationEnabled = false;                // To store tank filtration operation status    
+_Bool phaseRestored = false;                    // To indicate all phases are back after phase failure
+_Bool systemClockSynced = false;                // To indicate system clock is loaded from RTC
+_Bool rtcResyncDue = false;                     // To indicate system clock is to be resynced from RTC after each hour
 _Bool cmtiCmd = false;                          // Set to indicate cmti command received
-_Bool DeviceBurnStatus = false;                 // To store Device program status
-_Bool gsmSetToLocalTime = false;                // To indicate if gsm set to local timezone
-_Bool wetSensor = false;                        // To indicate if sensor is wet
+_Bool deliveryReportQuoted = false;             // To indicate quoted field of +CDS delivery report is being received
+_Bool deliveryReportReceived = false;           // To indicate +CDS delivery report is completed and to be queued
+_Bool deliveryReportPdu = false;                // To indicate +CDS delivery report is received in PDU mode
+_Bool deliveryReportNibblePending = false;      // To indicate high nibble of +CDS delivery report PDU octet is received
 //_Bool fertigationDry = false;                   // To indicate fertigation level
-_Bool fieldDueForCycles = false;                // To indicate field valve due for remaining cycles
-_Bool parallelValveFetched = false;              // To indicate if parallel valves fetched
+_Bool motorCurrentReady = false;                // To indicate filtered motor current is available after first sampling window
+volatile _Bool ctSamplingActive = false;        // To indicate CT sampling window is in progress
+_Bool i2cTransactionFailed = false;             // To indicate slave did not acknowledge or bus collision in I2C transaction
+volatile _Bool rtcTransferDone = false;         // To indicate DS1307 burst read or write is completed
+volatile _Bool rtcTransferFailed = false;       // To indicate DS1307 did not respond or time read from it is out of range
+volatile _Bool analogScanActive = false;        // To indicate background scan of analog channels is in progress
+_Bool analogValueReady = false;                 // To indicate all analog channels are measured at least once
 /************* BOOLeans definition#end ***********************************/
+
+/************* Packed flags definition#start *****************************/
+// Flags used only in main context are packed as bits of one flag word
+// Flags shared with interrupt handlers stay as separate _Bool above to avoid read-modify-write of a shared word
+struct SYSTEMFLAGS {
+    unsigned systemAuthenticated : 1;           // To check if system is initialized by user for first time.
+    unsigned currentDateCalled : 1;             // To avoid repetitive fetching of date through GSM
+    unsigned sleepCountChangedDueToInterrupt : 1; // TO check if sleep count need to calculate again if change due to GSM interrupt
+    unsigned dryRunDetected : 1;                // To state water level of tank --true for Low and --false for Full
+    unsigned lowPhaseCurrentDetected : 1;       // To state motor not started due to low phase current
+    unsigned valveDue : 1;                      // To indicate if any valve is due for operation after checking
+    unsigned valveExecuted : 1;                 // To indicate if valve executed
+    unsigned onHold : 1;                        // To indicate Field valve hold status
+    unsigned dueValveChecked : 1;               // To indicate valve due is checked at latest 
+    unsigned correctDate : 1;                   // To indicate received date is correct
+    unsigned lowRTCBatteryDetected : 1;         // To store RTC Battery level Status
+    unsigned rtcBatteryLevelChecked : 1;        // To indicate condition to check RTC battery level
+    unsigned filtrationEnabled : 1;             // To store tank filtration operation status    
+    unsigned DeviceBurnStatus : 1;              // To store Device program status
+    unsigned gsmSetToLocalTime : 1;             // To indicate if gsm set to local timezone
+    unsigned gsmHighBaudRate : 1;               // To indicate GSM link is running at 115200 baud
+    unsigned wetSensor : 1;                     // To indicate if sensor is wet
+    unsigned fieldDueForCycles : 1;             // To indicate field valve due for remaining cycles
+    unsigned parallelValveFetched : 1;          // To indicate if parallel valves fetched
+    unsigned motorLoadCalibrationRequired : 1;  // To indicate motor load cut-offs of earlier CT scale are cleared
+};
+struct SYSTEMFLAGS systemFlags = {0};
+#define systemAuthenticated systemFlags.systemAuthenticated
+#define currentDateCalled systemFlags.currentDateCalled
+#define sleepCountChangedDueToInterrupt systemFlags.sleepCountChangedDueToInterrupt
+#define dryRunDetected systemFlags.dryRunDetected
+#define lowPhaseCurrentDetected systemFlags.lowPhaseCurrentDetected
+#define valveDue systemFlags.valveDue
+#define valveExecuted systemFlags.valveExecuted
+#define onHold systemFlags.onHold
+#define dueValveChecked systemFlags.dueValveChecked
+#define correctDate systemFlags.correctDate
+#define lowRTCBatteryDetected systemFlags.lowRTCBatteryDetected
+#define rtcBatteryLevelChecked systemFlags.rtcBatteryLevelChecked
+#define filtrationEnabled systemFlags.filtrationEnabled
+#define DeviceBurnStatus systemFlags.DeviceBurnStatus
+#define gsmSetToLocalTime systemFlags.gsmSetToLocalTime
+#define gsmHighBaudRate systemFlags.gsmHighBaudRate
+#define wetSensor systemFlags.wetSensor
+#define fieldDueForCycles systemFlags.fieldDueForCycles
+#define parallelValveFetched systemFlags.parallelValveFetched
+#define motorLoadCalibrationRequired systemFlags.motorLoadCalibrationRequired
+/************* Packed flags definition#end *******************************/
 /***************************** Global variables definition#end ***********************/
 
 #endif